@@ -15,28 +15,44 @@
 #include "entities/Entity.hpp"
 #include "entities/EntityManager.hpp"
 #include "entities/TurnManager.hpp"
+#include "serialization/AutosaveService.hpp"
 #include "world/FeatureProperties.hpp"
 #include "world/Map.hpp"
 #include "world/MapViewAdapter.hpp"
 #include "world/Tile.hpp"
-#include "world/gen/LevelGenerator.hpp"
 
 #include <fstream>
 #include <iostream>
-#include <random>
 #include <sstream>
 
-Game::Game()
-    : playerPtr_(nullptr), running_(true), turnCounter_(0), depth_(1),
-      lookModeActive_(false), lookCursor_{0, 0} {
+namespace {
+constexpr int MAP_W = 60, MAP_H = 40;
+constexpr std::size_t GEN_THREADS = 1; // one level ahead needs one worker
+constexpr const char *AUTOSAVE_FILE = "autosave.sav";
+} // namespace
+
+Game::Game(std::uint64_t seed, int autosaveEvery)
+    : seed_(seed), running_(true), turnCounter_(0),
+      depth_(1), lookModeActive_(false), lookCursor_{0, 0},
+      autosaveEvery_(autosaveEvery) {
+
+  genPool_ = std::make_unique<core::ThreadPool>(GEN_THREADS);
+  levels_ = std::make_unique<world::LevelPregenerator>(*genPool_, seed_,
+                                                       MAP_W, MAP_H);
 
   inputMapper_ = std::make_unique<core::InputMapper>(core::Scheme::Vi);
   renderer_ = std::make_unique<renderers::FTXUIRenderer>(50, 19);
 
   generateLevel(); // TYLKO TO
 
+  if (autosaveEvery_ > 0) {
+    autosave_ =
+        std::make_unique<serialization::AutosaveService>(AUTOSAVE_FILE);
+  }
+
   addMessage("Welcome to the dungeon!");
   addMessage("Use hjkl/WASD to move, x to look, > to descend, q to quit");
+  addMessage("Dungeon seed " + std::to_string(seed_));
 }
 
 Game::~Game() = default;
@@ -57,8 +73,8 @@ void Game::render() {
   state.features = featureMgr_.get();
   state.fov = fov_.get();
   state.entities = entityMgr_.get();
-  state.player = playerPtr_;
-  state.cameraCenter = playerPtr_->getPosition();
+  state.player = player();
+  state.cameraCenter = state.player->getPosition();
   state.cursor = lookModeActive_ ? &lookCursor_ : nullptr;
 
   state.messages = messages_;
@@ -68,7 +84,7 @@ void Game::render() {
   state.depth = depth_;
   state.turn = turnCounter_;
 
-  state.discoveredTiles = discoveredTiles_;
+  state.exploration = &exploration_;
 
   // Render!
   renderer_->render(state);
@@ -98,7 +114,7 @@ void Game::handleInput() {
 
   // Handle player actions
   if (action == core::InputAction::Open) {
-    core::Position target = playerPtr_->getPosition();
+    core::Position target = player()->getPosition();
 
     // Check adjacent positions for doors (via Features)
     auto checkDoor = [this](core::Position pos) -> bool {
@@ -118,7 +134,7 @@ void Game::handleInput() {
       target.x += 1;
     }
 
-    actions::OpenAction open(*playerPtr_, target);
+    actions::OpenAction open(*player(), target);
     auto result = open.execute(*map_, *featureMgr_);
     addMessage(result.message);
 
@@ -131,9 +147,9 @@ void Game::handleInput() {
   } else if (action != core::InputAction::None) {
     // Movement
     core::Position delta = core::InputHandler::actionToDirection(action);
-    core::Position newPos = playerPtr_->getPosition() + delta;
+    core::Position newPos = player()->getPosition() + delta;
 
-    actions::MoveAction move(*playerPtr_, newPos);
+    actions::MoveAction move(*player(), newPos);
     auto result = move.execute(*map_, *featureMgr_, *entityMgr_, *turnMgr_);
 
     if (result.status == actions::ActionStatus::Success) {
@@ -152,51 +168,61 @@ void Game::handleInput() {
     turnCounter_++;
     processPlayerTurn();
     processAITurns();
-    fov_->compute(playerPtr_->getPosition(), 8);
+    if (!running_) {
+      return; // player died
+    }
+    fov_->compute(player()->getPosition(), 8);
 
     // Discover newly visible tiles
-    const int MAP_W = 60, MAP_H = 40;
-    for (int y = 0; y < MAP_H; ++y) {
-      for (int x = 0; x < MAP_W; ++x) {
-        if (fov_->isVisible(x, y)) {
-          // Check if already discovered
-          bool alreadyDiscovered = false;
-          for (const auto &tile : discoveredTiles_) {
-            if (tile.x == x && tile.y == y) {
-              alreadyDiscovered = true;
-              break;
-            }
-          }
-          if (!alreadyDiscovered) {
-            discoveredTiles_.push_back({x, y});
-          }
-        }
+    exploration_.mergeVisible(*fov_);
+
+    if (autosave_) {
+      if (turnCounter_ % autosaveEvery_ == 0) {
+        autosavePending_ = true;
+      }
+      if (autosavePending_) {
+        autosave();
       }
     }
   }
 }
 
-void Game::generateLevel() {
-  constexpr int MAP_W = 60, MAP_H = 40;
+void Game::autosave() {
+  // Worker still writing the last one: keep it pending, never block input
+  if (autosave_->busy()) {
+    return;
+  }
+  // Journaled: usually only what changed since the last autosave
+  autosave_->submitLevel(*map_, *featureMgr_, *entityMgr_, exploration_.bits(),
+                         depth_, turnCounter_);
+  autosavePending_ = false;
+
+  // Failures surface once the worker is done, i.e. on a later autosave
+  if (autosave_->failed() > autosaveFailures_) {
+    autosaveFailures_ = autosave_->failed();
+    addMessage("Autosave failed: " + autosave_->lastError());
+  }
+}
 
+void Game::generateLevel() {
   // Preserve HP BEFORE destroying entities
   int preservedHP = 100; // Default for first level
-  if (playerPtr_ != nullptr) {
-    preservedHP = playerPtr_->getProperty("hp");
+  if (const entities::Entity *current = player()) {
+    preservedHP = current->get(entities::Prop::HP);
   }
 
   // Clear existing entities
-  entityMgr_ = std::make_unique<entities::EntityManager>();
+  entityMgr_ = std::make_unique<entities::EntityManager>(MAP_W, MAP_H);
   turnMgr_ = std::make_unique<entities::TurnManager>();
 
-  // Generate level using new LevelGenerator
-  std::mt19937 rng(std::random_device{}());
-  world::LevelGenerator generator(rng);
-  world::LevelData levelData = generator.generateLevel(MAP_W, MAP_H, depth_);
+  // Usually already generated in the background; queues the next depth
+  world::LevelData levelData = levels_->take(depth_);
 
   // Take ownership of generated map and features
   map_ = std::move(levelData.map);
   featureMgr_ = std::move(levelData.features);
+  mapView_ = std::make_unique<world::MapViewAdapter>(*map_);
+  levelView_ = std::make_unique<world::LevelView>(*map_, *featureMgr_);
 
   // DEBUG - count stairs via features
   int stairsCount = 0;
@@ -213,43 +239,47 @@ void Game::generateLevel() {
   core::Position spawnPos = levelData.player_spawn;
 
   // Recreate player at spawn
-  auto player = std::make_unique<entities::Entity>("Player", spawnPos);
-  player->setMaxHP(100);
-  player->setHP(preservedHP); // Use preserved value
-  player->setProperty("speed", 100);
-  player->setProperty("str", 10);
-  player->setGlyph('@');
-  playerPtr_ = player.get();
-  entityMgr_->addEntity(std::move(player));
-  turnMgr_->addEntity(playerPtr_);
+  entities::Entity &hero = entityMgr_->createEntity("Player", spawnPos);
+  hero.setMaxHP(100);
+  hero.setHP(preservedHP); // Use preserved value
+  hero.set(entities::Prop::Speed, 100);
+  hero.set(entities::Prop::Str, 10);
+  hero.setGlyph('@');
+  playerId_ = hero.getId();
+  turnMgr_->addEntity(hero);
+
+  // Monsters chase the player through one shared distance field
+  chaseMap_ =
+      std::make_unique<core::BasicDijkstraMap<world::LevelView>>(*levelView_);
+  chaseTarget_ = spawnPos;
+  chaseMap_->addGoal(chaseTarget_);
+  chaseMap_->compute();
 
   // Spawn monsters at generated positions
   for (const auto &monsterPos : levelData.monster_spawns) {
-    auto monster = std::make_unique<entities::Entity>("Goblin", monsterPos);
-    monster->setMaxHP(30);
-    monster->setHP(20);
-    monster->setProperty("str", 2);
-    monster->setProperty("phys_res", 2);
-    monster->setProperty("speed", 100);
-    monster->setGlyph('g');
-    monster->setAI(std::make_unique<ai::SimpleAI>(8));
-    entities::Entity *monsterPtr = monster.get();
-    entityMgr_->addEntity(std::move(monster));
-    turnMgr_->addEntity(monsterPtr);
+    entities::Entity &monster =
+        entityMgr_->createEntity("Goblin", monsterPos);
+    monster.setMaxHP(30);
+    monster.setHP(20);
+    monster.set(entities::Prop::Str, 2);
+    monster.set(entities::Prop::PhysRes, 2);
+    monster.set(entities::Prop::Speed, 100);
+    monster.setGlyph('g');
+    auto ai = std::make_unique<ai::SimpleAI>(8);
+    ai->setChaseMap(chaseMap_.get());
+    monster.setAI(std::move(ai));
+    turnMgr_->addEntity(monster);
   }
 
   // Reset FOV and discovered tiles
-  mapView_ = std::make_unique<world::MapViewAdapter>(*map_);
   fov_ = std::make_unique<core::FOV>(*mapView_);
-  fov_->compute(playerPtr_->getPosition(), 8);
+  fov_->compute(hero.getPosition(), 8);
 
-  discoveredTiles_.clear();
-  for (int y = 0; y < MAP_H; ++y) {
-    for (int x = 0; x < MAP_W; ++x) {
-      if (fov_->isVisible(x, y)) {
-        discoveredTiles_.push_back({x, y});
-      }
-    }
+  exploration_ = world::ExplorationMemory(map_->width(), map_->height());
+  exploration_.mergeVisible(*fov_);
+
+  if (autosave_) {
+    autosave_->levelChanged();
   }
 }
 
@@ -258,11 +288,11 @@ void Game::descendStairs() {
   std::cout.flush();
 
   // Save state
-  int currentHP = playerPtr_->getProperty("hp");
+  int currentHP = player()->get(entities::Prop::HP);
   std::cout << "HP saved: " << currentHP << "\n";
   std::cout.flush();
 
-  core::Position playerPos = playerPtr_->getPosition();
+  core::Position playerPos = player()->getPosition();
   std::cout << "Position: " << playerPos.x << "," << playerPos.y << "\n";
   std::cout.flush();
 
@@ -293,7 +323,7 @@ void Game::descendStairs() {
   std::cout << "Level generated, restoring HP\n";
   std::cout.flush();
 
-  playerPtr_->setProperty("hp", currentHP);
+  player()->set(entities::Prop::HP, currentHP);
 
   std::cout << "Done!\n";
   std::cout.flush();
@@ -302,7 +332,7 @@ void Game::descendStairs() {
 }
 
 void Game::handleLookMode() {
-  lookCursor_ = playerPtr_->getPosition();
+  lookCursor_ = player()->getPosition();
   lookModeActive_ = true;
 
   bool looking = true;
@@ -310,7 +340,7 @@ void Game::handleLookMode() {
 
   while (looking) {
     // Update look info
-    lookInfo_ = getInfoAt(lookCursor_, playerPtr_->getPosition());
+    lookInfo_ = getInfoAt(lookCursor_, player()->getPosition());
 
     // Render
     render();
@@ -338,22 +368,44 @@ void Game::handleLookMode() {
   }
 }
 
+entities::Entity *Game::player() const {
+  return entityMgr_ ? entityMgr_->get(playerId_) : nullptr;
+}
+
 void Game::processPlayerTurn() { turnMgr_->processTurn(); }
 
 void Game::processAITurns() {
+  // Player does not move during AI turns - one refresh covers all monsters
+  const core::Position playerPos = player()->getPosition();
+  if (playerPos != chaseTarget_) {
+    chaseTarget_ = playerPos;
+    chaseMap_->clearGoals();
+    chaseMap_->addGoal(chaseTarget_);
+    chaseMap_->compute();
+  }
+
   while (!turnMgr_->isEmpty()) {
-    entities::Entity *actor = turnMgr_->getNextActor();
+    const core::EntityId actorId = turnMgr_->getNextActor();
 
-    if (actor == playerPtr_) {
+    if (actorId == playerId_) {
       break;
     }
 
+    entities::Entity *actor = entityMgr_->get(actorId);
+
     if (actor->hasAI()) {
-      auto result = actor->getAI()->act(*actor, *playerPtr_, *map_,
+      auto result = actor->getAI()->act(*actor, *player(), *map_,
                                         *featureMgr_, *entityMgr_, *turnMgr_);
       if (!result.message.empty()) {
         addMessage(result.message);
       }
+
+      // Player killed - its id no longer resolves
+      if (!entityMgr_->contains(playerId_)) {
+        addMessage("You die...");
+        running_ = false;
+        return;
+      }
     }
 
     turnMgr_->processTurn();
@@ -412,7 +464,7 @@ std::string Game::getInfoAt(const core::Position &pos,
   entities::Entity *entity = entityMgr_->getEntityAt(pos);
   if (entity) {
     info << " | " << entity->getName();
-    info << " (HP:" << entity->getProperty("hp") << ")";
+    info << " (HP:" << entity->get(entities::Prop::HP) << ")";
   }
 
   return info.str();
@@ -1,19 +1,30 @@
 #pragma once
+#include "core/DijkstraMap.hpp"
 #include "core/InputMapper.hpp"
+#include "core/ThreadPool.hpp"
 #include "entities/TurnManager.hpp"
 #include "renderers/FTXUIRenderer.hpp"
+#include "world/ExplorationMemory.hpp"
 #include "world/Map.hpp"
 #include "world/FeatureManager.hpp"
+#include "world/LevelView.hpp"
 #include "world/MapViewAdapter.hpp"
+#include "world/gen/LevelPregenerator.hpp"
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <vector>
 
 // Forward declarations as before...
+namespace serialization {
+class AutosaveService;
+}
 
 class Game {
 public:
-  Game();
+  // Same seed -> same dungeon (every depth is derived from it).
+  // autosaveEvery > 0 saves in the background every that many turns.
+  explicit Game(std::uint64_t seed, int autosaveEvery = 0);
   ~Game();
 
   void run();
@@ -27,15 +38,30 @@ private:
   void processAITurns();
   void render();
   void addMessage(const std::string &msg);
+  void autosave();
+  // nullptr before the first level and once the player is dead
+  entities::Entity *player() const;
 
   std::string getInfoAt(const core::Position &pos,
                         const core::Position &playerPos) const;
 
+  // Level generation: next depths are built on worker threads while the
+  // current one is played (pool declared first, outlives the jobs' owner)
+  std::uint64_t seed_;
+  std::unique_ptr<core::ThreadPool> genPool_;
+  std::unique_ptr<world::LevelPregenerator> levels_;
+
   // Game state
   std::unique_ptr<world::Map> map_;
   std::unique_ptr<world::FeatureManager> featureMgr_;
   std::unique_ptr<world::MapViewAdapter> mapView_;
   std::unique_ptr<core::FOV> fov_;
+  // Distance field towards the player shared by all monster AIs,
+  // recomputed only when the player has moved. Built over the door-aware
+  // LevelView so it agrees with MoveAction (and monster A*) on walkability
+  std::unique_ptr<world::LevelView> levelView_;
+  std::unique_ptr<core::BasicDijkstraMap<world::LevelView>> chaseMap_;
+  core::Position chaseTarget_;
   std::unique_ptr<entities::EntityManager> entityMgr_;
   std::unique_ptr<entities::TurnManager> turnMgr_;
   std::unique_ptr<core::InputMapper> inputMapper_;
@@ -45,13 +71,20 @@ private:
 
   // UI state
   std::vector<std::string> messages_;
-  std::vector<core::Position> discoveredTiles_;
+  world::ExplorationMemory exploration_; // tiles seen on this level
   std::string lookInfo_;
   bool lookModeActive_;
   core::Position lookCursor_;
 
-  entities::Entity *playerPtr_;
+  // The player is held by id only; player() resolves it on each use
+  core::EntityId playerId_;
   bool running_;
   int turnCounter_;
   int depth_;
+
+  // Background saves (snapshot here, encode + write on a worker)
+  std::unique_ptr<serialization::AutosaveService> autosave_;
+  int autosaveEvery_;
+  bool autosavePending_ = false; // due, previous save still in flight
+  std::uint64_t autosaveFailures_ = 0; // already reported to the player
 };
@@ -32,10 +32,10 @@ ActionResult MoveAction::execute(world::Map &map,
   if (target_entity) {
     // Bump attack!
     auto result = systems::CombatSystem::meleeAttack(actor_, *target_entity);
-    //  Remove if killed
+    //  Remove if killed (unschedule by id before the entity is destroyed)
     if (result.killed) {
+      turnMgr.removeEntity(target_entity->getId());
       entities.removeEntity(target_entity);
-      turnMgr.removeEntity(target_entity);
     }
 
     return ActionResult::success(result.message, 100);
@@ -29,14 +29,14 @@ ActionResult OpenAction::execute(world::Map &map,
     return ActionResult::failure("Nothing to open here");
   }
 
-  world::Door *door = world::getDoor(*feature);
+  const world::Door *door = world::getDoor(*feature);
   
   if (door->state == world::Door::State::Open) {
     return ActionResult::failure("Door already open");
   }
 
-  // Open the door
-  door->state = world::Door::State::Open;
+  // Open the door (through the manager, so the map layers follow)
+  features.setDoorState(target_, world::Door::State::Open);
   return ActionResult::success("Door opened", 100);
 }
 
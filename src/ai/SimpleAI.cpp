@@ -1,48 +1,104 @@
 #include "SimpleAI.hpp"
 #include "actions/MoveAction.hpp"
+#include "core/Profiler.hpp"
 #include "entities/Entity.hpp"
 #include "entities/EntityManager.hpp"
 #include "entities/TurnManager.hpp"
 #include "world/Map.hpp"
-#include "world/MapViewAdapter.hpp"
 
 namespace ai {
 
 SimpleAI::SimpleAI(int vision_range) : vision_range_(vision_range) {}
 
+void SimpleAI::bindMap(const world::Map &map,
+                       const world::FeatureManager &features) {
+  if (boundMap_ == &map && boundFeatures_ == &features && view_ &&
+      view_->width() == map.width() && view_->height() == map.height())
+    return;
+
+  boundMap_ = &map;
+  boundFeatures_ = &features;
+  view_ = std::make_unique<world::LevelView>(map, features);
+  fov_ = std::make_unique<core::BasicFOV<world::LevelView>>(*view_);
+  pathfinder_ =
+      std::make_unique<core::BasicPathfinding<world::LevelView>>(*view_);
+  path_.clear();
+  failedRetryIn_ = 0;
+}
+
+std::optional<core::Position>
+SimpleAI::nextPathStep(const core::Position &from, const core::Position &goal) {
+  // Last step succeeded - advance along the cached path
+  if (pathIndex_ + 1 < path_.size() && path_[pathIndex_ + 1] == from)
+    ++pathIndex_;
+
+  if (pathIndex_ + 1 < path_.size() && path_[pathIndex_] == from &&
+      path_.back() == goal) {
+    const core::Position next = path_[pathIndex_ + 1];
+    if (!view_->blocksMovement(next.x, next.y))
+      return next;
+  }
+
+  if (from == failedFrom_ && goal == failedGoal_ && failedRetryIn_ > 0) {
+    --failedRetryIn_;
+    return std::nullopt;
+  }
+
+  path_ = pathfinder_->findPath(from, goal);
+  pathIndex_ = 0;
+  if (path_.size() < 2) {
+    path_.clear();
+    failedFrom_ = from;
+    failedGoal_ = goal;
+    failedRetryIn_ = FAILED_SEARCH_RETRY;
+    return std::nullopt;
+  }
+  return path_[1];
+}
+
 actions::ActionResult SimpleAI::act(entities::Entity &self,
                                     const entities::Entity &player,
                                     world::Map &map,
                                     world::FeatureManager &features,
                                     entities::EntityManager &entities,
                                     entities::TurnManager &turnMgr) {
+  core::ProfileScope profile(core::ProfileBucket::AI);
 
   core::Position selfPos = self.getPosition();
   core::Position playerPos = player.getPosition();
 
-  // Create fresh adapter and systems each time
-  world::MapViewAdapter adapter(map);
-  core::FOV fov(adapter);
-  core::Pathfinding pathfinder(adapter);
+  bindMap(map, features);
 
   // Compute FOV from self position
-  fov.compute(selfPos, vision_range_);
+  fov_->compute(selfPos, vision_range_);
 
   // Can we see player?
-  if (!fov.isVisible(playerPos.x, playerPos.y)) {
+  if (!fov_->isVisible(playerPos.x, playerPos.y)) {
     return actions::ActionResult::success("", 100);
   }
 
-  // Player visible - pathfind towards them
-  auto path = pathfinder.findPath(selfPos, playerPos);
+  // Player visible - descend shared chase map if it covers this map.
+  // Cells held by other monsters are skipped so the pack spreads around
+  // them instead of bump-attacking each other.
+  if (chaseMap_ && chaseMap_->width() == map.width() &&
+      chaseMap_->height() == map.height()) {
+    auto step = chaseMap_->nextStep(selfPos, [&](const core::Position &pos) {
+      return pos == playerPos || entities.getEntityAt(pos) == nullptr;
+    });
+    if (!step) {
+      return actions::ActionResult::success("", 100);
+    }
+    actions::MoveAction move(self, *step);
+    return move.execute(map, features, entities, turnMgr);
+  }
 
-  if (path.empty() || path.size() < 2) {
+  // No chase map - pathfind towards them
+  const auto nextPos = nextPathStep(selfPos, playerPos);
+  if (!nextPos) {
     return actions::ActionResult::success("", 100);
   }
 
-  // Move to next position
-  core::Position nextPos = path[1];
-  actions::MoveAction move(self, nextPos);
+  actions::MoveAction move(self, *nextPos);
   return move.execute(map, features, entities, turnMgr);
 }
 
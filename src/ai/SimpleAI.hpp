@@ -1,8 +1,13 @@
 #pragma once
 #include "AIBehavior.hpp"
+#include "core/DijkstraMap.hpp"
 #include "core/FOV.hpp"
 #include "core/Pathfinding.hpp"
+#include "world/LevelView.hpp"
+#include <cstddef>
 #include <memory>
+#include <optional>
+#include <vector>
 
 namespace ai {
 
@@ -17,10 +22,50 @@ public:
                             entities::EntityManager &entities,
                             entities::TurnManager &turnMgr) override;
 
+  // Optional shared distance field towards the player (owned by caller).
+  // When set, a visible player is chased by descending it instead of
+  // running A* per monster; nullptr restores per-monster A*. Built over
+  // LevelView, so it walks the same cells as the A* fallback.
+  void setChaseMap(
+      const core::BasicDijkstraMap<world::LevelView> *chaseMap) noexcept {
+    chaseMap_ = chaseMap;
+  }
+
 private:
   int vision_range_;
-  //  std::unique_ptr<FOV> fov_;
-  //  std::unique_ptr<core::Pathfinding> pathfinder_;
+  const core::BasicDijkstraMap<world::LevelView> *chaseMap_ = nullptr;
+
+  // Failed searches are not repeated for this many act() calls while
+  // neither endpoint moves (a door may open meanwhile)
+  static constexpr int FAILED_SEARCH_RETRY = 8;
+
+  // Kept between turns so FOV bits and A* node arrays are allocated once
+  // per map, not once per act() call. Instantiated on the door-aware
+  // LevelView, so the per-cell test is an inlined bit read, closed doors
+  // stop sight, and paths never lead through them.
+  const world::Map *boundMap_ = nullptr;
+  const world::FeatureManager *boundFeatures_ = nullptr;
+  std::unique_ptr<world::LevelView> view_;
+  std::unique_ptr<core::BasicFOV<world::LevelView>> fov_;
+  std::unique_ptr<core::BasicPathfinding<world::LevelView>> pathfinder_;
+
+  // Last A* result; path_[pathIndex_] is where we stood when last stepping
+  std::vector<core::Position> path_;
+  std::size_t pathIndex_ = 0;
+
+  // Last search that found nothing
+  core::Position failedFrom_{-1, -1};
+  core::Position failedGoal_{-1, -1};
+  int failedRetryIn_ = 0;
+
+  // (Re)creates view, FOV and pathfinder when acting on a different level
+  void bindMap(const world::Map &map, const world::FeatureManager &features);
+
+  // Next step from -> goal: follows the cached path while it still
+  // starts here, ends at goal and its next cell is passable; otherwise
+  // runs A* (unless the same search failed recently)
+  std::optional<core::Position> nextPathStep(const core::Position &from,
+                                             const core::Position &goal);
 };
 
 } // namespace ai
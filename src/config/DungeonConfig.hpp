@@ -33,6 +33,7 @@ struct LevelConfig {
   world::CavesOptions caves;
   RoomPlacementConfig room_placement;
   CaveGenerationConfig cave_generation;
+  int monster_count = 20; // Monster spawn points requested per level
 
   // Constructor with sensible defaults
   LevelConfig() {
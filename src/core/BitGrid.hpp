@@ -0,0 +1,190 @@
+#pragma once
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace core {
+
+// Dense 2D bitset stored as one contiguous buffer.
+// Each row is padded to whole 64-bit words, so rows can be processed
+// word-at-a-time (bit i of word w in row y is cell x = w * 64 + i).
+// Padding bits past width() are always kept at 0.
+class BitGrid {
+public:
+  using Word = std::uint64_t;
+  static constexpr int WORD_BITS = 64;
+
+  BitGrid() = default;
+  BitGrid(int width, int height, bool value = false)
+      : w_(width), h_(height),
+        stride_((static_cast<std::size_t>(width) + WORD_BITS - 1) / WORD_BITS),
+        bits_(stride_ * static_cast<std::size_t>(height), 0) {
+    assert(width >= 0 && height >= 0);
+    if (value)
+      fill(true);
+  }
+
+  int width() const noexcept { return w_; }
+  int height() const noexcept { return h_; }
+  std::size_t wordsPerRow() const noexcept { return stride_; }
+
+  bool inBounds(int x, int y) const noexcept {
+    return x >= 0 && y >= 0 && x < w_ && y < h_;
+  }
+
+  bool test(int x, int y) const noexcept {
+    assert(inBounds(x, y));
+    return (bits_[wordIndex(x, y)] >> bitIndex(x)) & 1u;
+  }
+
+  void set(int x, int y) noexcept {
+    assert(inBounds(x, y));
+    bits_[wordIndex(x, y)] |= Word{1} << bitIndex(x);
+  }
+
+  void reset(int x, int y) noexcept {
+    assert(inBounds(x, y));
+    bits_[wordIndex(x, y)] &= ~(Word{1} << bitIndex(x));
+  }
+
+  void assign(int x, int y, bool value) noexcept {
+    if (value)
+      set(x, y);
+    else
+      reset(x, y);
+  }
+
+  // Set or clear every cell
+  void fill(bool value) noexcept {
+    for (int y = 0; y < h_; ++y) {
+      std::span<Word> r = row(y);
+      for (std::size_t i = 0; i < stride_; ++i)
+        r[i] = value ? ~Word{0} : Word{0};
+      if (value && stride_ > 0)
+        r[stride_ - 1] &= tailMask();
+    }
+  }
+
+  // Clear all cells in inclusive rectangle [x0, x1] x [y0, y1] (clamped)
+  // using word masks - cost is proportional to rectangle, not grid size
+  void clearRect(int x0, int y0, int x1, int y1) noexcept {
+    if (!clampRect(x0, y0, x1, y1))
+      return;
+    const std::size_t w0 = static_cast<std::size_t>(x0) / WORD_BITS;
+    const std::size_t w1 = static_cast<std::size_t>(x1) / WORD_BITS;
+    for (int y = y0; y <= y1; ++y) {
+      std::span<Word> r = row(y);
+      for (std::size_t w = w0; w <= w1; ++w)
+        r[w] &= ~spanMask(w, x0, x1);
+    }
+  }
+
+  // Row access for word-level processing
+  std::span<const Word> row(int y) const noexcept {
+    assert(y >= 0 && y < h_);
+    return {bits_.data() + static_cast<std::size_t>(y) * stride_, stride_};
+  }
+  std::span<Word> row(int y) noexcept {
+    assert(y >= 0 && y < h_);
+    return {bits_.data() + static_cast<std::size_t>(y) * stride_, stride_};
+  }
+
+  std::span<const Word> words() const noexcept { return bits_; }
+  std::span<Word> words() noexcept { return bits_; }
+
+  // Number of set cells
+  std::size_t count() const noexcept {
+    std::size_t n = 0;
+    for (Word word : bits_)
+      n += static_cast<std::size_t>(std::popcount(word));
+    return n;
+  }
+
+  // True if any cell inside inclusive rectangle (clamped) is set
+  bool anyInRect(int x0, int y0, int x1, int y1) const noexcept {
+    if (!clampRect(x0, y0, x1, y1))
+      return false;
+    const std::size_t w0 = static_cast<std::size_t>(x0) / WORD_BITS;
+    const std::size_t w1 = static_cast<std::size_t>(x1) / WORD_BITS;
+    for (int y = y0; y <= y1; ++y) {
+      std::span<const Word> r = row(y);
+      for (std::size_t w = w0; w <= w1; ++w)
+        if (r[w] & spanMask(w, x0, x1))
+          return true;
+    }
+    return false;
+  }
+
+  // Calls fn(x, y) for every set cell, row-major order
+  template <typename Fn> void forEachSet(Fn &&fn) const {
+    forEachSetInRect(0, 0, w_ - 1, h_ - 1, fn);
+  }
+
+  // Calls fn(x, y) for every set cell inside inclusive rectangle (clamped).
+  // Skips empty words, so sparse grids are cheap to walk.
+  template <typename Fn>
+  void forEachSetInRect(int x0, int y0, int x1, int y1, Fn &&fn) const {
+    if (!clampRect(x0, y0, x1, y1))
+      return;
+    const std::size_t w0 = static_cast<std::size_t>(x0) / WORD_BITS;
+    const std::size_t w1 = static_cast<std::size_t>(x1) / WORD_BITS;
+    for (int y = y0; y <= y1; ++y) {
+      std::span<const Word> r = row(y);
+      for (std::size_t w = w0; w <= w1; ++w) {
+        Word word = r[w] & spanMask(w, x0, x1);
+        while (word) {
+          const int bit = std::countr_zero(word);
+          fn(static_cast<int>(w) * WORD_BITS + bit, y);
+          word &= word - 1;
+        }
+      }
+    }
+  }
+
+private:
+  std::size_t wordIndex(int x, int y) const noexcept {
+    return static_cast<std::size_t>(y) * stride_ +
+           static_cast<std::size_t>(x) / WORD_BITS;
+  }
+  static unsigned bitIndex(int x) noexcept {
+    return static_cast<unsigned>(x) % WORD_BITS;
+  }
+
+  // Valid bits of the last word in a row
+  Word tailMask() const noexcept {
+    const unsigned used = static_cast<unsigned>(w_) % WORD_BITS;
+    return used == 0 ? ~Word{0} : (Word{1} << used) - 1;
+  }
+
+  // Bits of word w that fall into columns [x0, x1]
+  static Word spanMask(std::size_t w, int x0, int x1) noexcept {
+    const int base = static_cast<int>(w) * WORD_BITS;
+    const int lo = x0 > base ? x0 - base : 0;
+    const int hi = x1 < base + WORD_BITS - 1 ? x1 - base : WORD_BITS - 1;
+    const Word upper =
+        hi == WORD_BITS - 1 ? ~Word{0} : (Word{1} << (hi + 1)) - 1;
+    return upper & ~((Word{1} << lo) - 1);
+  }
+
+  bool clampRect(int &x0, int &y0, int &x1, int &y1) const noexcept {
+    if (x0 < 0)
+      x0 = 0;
+    if (y0 < 0)
+      y0 = 0;
+    if (x1 >= w_)
+      x1 = w_ - 1;
+    if (y1 >= h_)
+      y1 = h_ - 1;
+    return x0 <= x1 && y0 <= y1;
+  }
+
+  int w_ = 0;
+  int h_ = 0;
+  std::size_t stride_ = 0;
+  std::vector<Word> bits_;
+};
+
+} // namespace core
@@ -0,0 +1,7 @@
+#include "DijkstraMap.hpp"
+
+namespace core {
+
+template class BasicDijkstraMap<IMapView>;
+
+} // namespace core
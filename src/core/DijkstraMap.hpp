@@ -0,0 +1,195 @@
+#pragma once
+#include "IMapView.hpp"
+#include "MapView.hpp"
+#include "Position.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace core {
+
+// Distance field ("Dijkstra map") over walkable cells.
+// One compute() gives every cell its distance to the nearest goal, so any
+// number of actors can walk towards the goals by steepest descent in O(1)
+// each, instead of running one search per actor.
+// Movement model matches BasicPathfinding on the same view: 8 directions,
+// cost 1 per step, cells blocked when viewBlocksMovement(). Templated on
+// the map view like BasicPathfinding; DijkstraMap is the IMapView
+// (virtual) instantiation.
+template <MapView View> class BasicDijkstraMap {
+public:
+  static constexpr int UNREACHABLE = std::numeric_limits<int>::max();
+
+  explicit BasicDijkstraMap(const View &map);
+
+  // Goals: cells with a starting value (0 = target, lower = more attractive)
+  void clearGoals();
+  void addGoal(const Position &pos, int value = 0);
+
+  // Multi-source breadth-first fill from all goals, O(cells)
+  void compute();
+
+  // Turns an approach map into a flee map: values are scaled by coefficient
+  // (negative, e.g. -1.2) and relaxed again, so descending leads away from
+  // the goals but still around dead ends. Requires compute() first.
+  void invert(double coefficient = -1.2);
+
+  int width() const noexcept { return width_; }
+  int height() const noexcept { return height_; }
+
+  // Distance value at cell, UNREACHABLE for walls/unreached/out of bounds
+  int valueAt(int x, int y) const noexcept;
+  bool isReachable(int x, int y) const noexcept {
+    return valueAt(x, y) != UNREACHABLE;
+  }
+
+  // Steepest descent: neighbor with lowest value strictly below current
+  std::optional<Position> nextStep(const Position &from) const {
+    return nextStep(from, [](const Position &) { return true; });
+  }
+
+  // Same, skipping neighbors rejected by canEnter(pos) (e.g. occupied cells)
+  template <typename CanEnter>
+  std::optional<Position> nextStep(const Position &from,
+                                   CanEnter &&canEnter) const {
+    static constexpr int DX[] = {0, 1, 1, 1, 0, -1, -1, -1};
+    static constexpr int DY[] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+    int best = valueAt(from.x, from.y);
+    std::optional<Position> step;
+    for (int i = 0; i < 8; ++i) {
+      const Position next{from.x + DX[i], from.y + DY[i]};
+      const int v = valueAt(next.x, next.y);
+      if (v < best && canEnter(next)) {
+        best = v;
+        step = next;
+      }
+    }
+    return step;
+  }
+
+private:
+  struct Seed {
+    int value;
+    std::size_t id;
+  };
+
+  const View &map_;
+  int width_;
+  int height_;
+  std::vector<int> dist_;
+  std::vector<Seed> goals_;
+
+  // Scratch buffers reused between computes
+  std::vector<Seed> seeds_;
+  std::vector<Seed> queue_;
+
+  // Dijkstra with unit edges from seeds of arbitrary value: seeds sorted by
+  // value and merged into a FIFO frontier whose values never decrease
+  void relaxFrom(std::vector<Seed> &seeds);
+};
+
+using DijkstraMap = BasicDijkstraMap<IMapView>;
+
+template <MapView View>
+BasicDijkstraMap<View>::BasicDijkstraMap(const View &map)
+    : map_(map), width_(map.width()), height_(map.height()),
+      dist_(static_cast<std::size_t>(width_) *
+                static_cast<std::size_t>(height_),
+            UNREACHABLE) {}
+
+template <MapView View> void BasicDijkstraMap<View>::clearGoals() {
+  goals_.clear();
+}
+
+template <MapView View>
+void BasicDijkstraMap<View>::addGoal(const Position &pos, int value) {
+  if (pos.x < 0 || pos.x >= width_ || pos.y < 0 || pos.y >= height_)
+    return;
+  goals_.push_back({value, static_cast<std::size_t>(pos.y * width_ + pos.x)});
+}
+
+template <MapView View>
+int BasicDijkstraMap<View>::valueAt(int x, int y) const noexcept {
+  if (x < 0 || x >= width_ || y < 0 || y >= height_)
+    return UNREACHABLE;
+  return dist_[static_cast<std::size_t>(y * width_ + x)];
+}
+
+template <MapView View> void BasicDijkstraMap<View>::compute() {
+  ProfileScope profile(ProfileBucket::Pathfinding);
+
+  seeds_.assign(goals_.begin(), goals_.end());
+  relaxFrom(seeds_);
+}
+
+template <MapView View>
+void BasicDijkstraMap<View>::invert(double coefficient) {
+  ProfileScope profile(ProfileBucket::Pathfinding);
+
+  seeds_.clear();
+  for (std::size_t id = 0; id < dist_.size(); ++id) {
+    if (dist_[id] != UNREACHABLE)
+      seeds_.push_back(
+          {static_cast<int>(std::lround(dist_[id] * coefficient)), id});
+  }
+  relaxFrom(seeds_);
+}
+
+template <MapView View>
+void BasicDijkstraMap<View>::relaxFrom(std::vector<Seed> &seeds) {
+  static constexpr int DX[] = {0, 1, 1, 1, 0, -1, -1, -1};
+  static constexpr int DY[] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+  std::fill(dist_.begin(), dist_.end(), UNREACHABLE);
+  std::stable_sort(
+      seeds.begin(), seeds.end(),
+      [](const Seed &a, const Seed &b) { return a.value < b.value; });
+
+  queue_.clear();
+  std::size_t head = 0;
+  std::size_t nextSeed = 0;
+
+  while (nextSeed < seeds.size() || head < queue_.size()) {
+    // Take whichever of (next seed, queue front) has the lower value
+    Seed current;
+    if (head == queue_.size() ||
+        (nextSeed < seeds.size() &&
+         seeds[nextSeed].value <= queue_[head].value)) {
+      current = seeds[nextSeed++];
+      const int cx = static_cast<int>(current.id) % width_;
+      const int cy = static_cast<int>(current.id) / width_;
+      if (viewBlocksMovement(map_, cx, cy) ||
+          current.value >= dist_[current.id])
+        continue;
+      dist_[current.id] = current.value;
+    } else {
+      current = queue_[head++];
+      if (current.value != dist_[current.id])
+        continue; // superseded by a lower value
+    }
+
+    const int x = static_cast<int>(current.id) % width_;
+    const int y = static_cast<int>(current.id) / width_;
+    const int next = current.value + 1;
+    for (int i = 0; i < 8; ++i) {
+      const int nx = x + DX[i];
+      const int ny = y + DY[i];
+      if (nx < 0 || nx >= width_ || ny < 0 || ny >= height_)
+        continue;
+      const std::size_t nid = static_cast<std::size_t>(ny * width_ + nx);
+      if (next >= dist_[nid] || viewBlocksMovement(map_, nx, ny))
+        continue;
+      dist_[nid] = next;
+      queue_.push_back({next, nid});
+    }
+  }
+}
+
+extern template class BasicDijkstraMap<IMapView>;
+
+} // namespace core
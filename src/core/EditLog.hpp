@@ -0,0 +1,65 @@
+#pragma once
+#include "Position.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace core {
+
+// Revision counter plus a bounded ring of the most recent cell edits.
+// Every record() bumps the revision; changedSince(rev, rect) answers
+// "did anything inside rect change after rev?" exactly while the edits
+// are still in the ring, and conservatively (true) once they have been
+// overwritten or after a recordAll().
+class EditLog {
+public:
+  static constexpr std::size_t DEFAULT_CAPACITY = 64;
+
+  explicit EditLog(std::size_t capacity = DEFAULT_CAPACITY)
+      : cells_(capacity == 0 ? 1 : capacity) {}
+
+  std::uint64_t revision() const noexcept { return revision_; }
+
+  // One cell changed
+  void record(int x, int y) noexcept {
+    ++revision_;
+    cells_[slot(revision_)] = Position{x, y};
+  }
+
+  // Everything may have changed (fill, reload)
+  void recordAll() noexcept {
+    ++revision_;
+    cells_[slot(revision_)] = Position{NOWHERE, NOWHERE};
+    allRevision_ = revision_;
+  }
+
+  // True if an edit after revision since may have touched the inclusive
+  // rectangle
+  bool changedSince(std::uint64_t since, int x0, int y0, int x1,
+                    int y1) const noexcept {
+    if (since >= revision_)
+      return false;
+    if (allRevision_ > since || revision_ - since > cells_.size())
+      return true;
+    for (std::uint64_t r = since + 1; r <= revision_; ++r) {
+      const Position &p = cells_[slot(r)];
+      if (p.x >= x0 && p.x <= x1 && p.y >= y0 && p.y <= y1)
+        return true;
+    }
+    return false;
+  }
+
+private:
+  static constexpr int NOWHERE = std::numeric_limits<int>::min();
+
+  std::size_t slot(std::uint64_t revision) const noexcept {
+    return static_cast<std::size_t>(revision % cells_.size());
+  }
+
+  std::vector<Position> cells_;
+  std::uint64_t revision_ = 0;
+  std::uint64_t allRevision_ = 0; // last recordAll()
+};
+
+} // namespace core
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <limits>
+
+namespace core {
+
+// Stable handle to an entity: slot index plus the slot's generation.
+// A removed entity's slot gets a new generation, so old ids stop
+// resolving instead of pointing at whatever reuses the slot.
+struct EntityId {
+  static constexpr std::uint32_t INVALID_INDEX =
+      std::numeric_limits<std::uint32_t>::max();
+
+  std::uint32_t index = INVALID_INDEX;
+  std::uint32_t generation = 0;
+
+  constexpr bool valid() const noexcept { return index != INVALID_INDEX; }
+
+  constexpr bool operator==(const EntityId &other) const noexcept {
+    return index == other.index && generation == other.generation;
+  }
+  constexpr bool operator!=(const EntityId &other) const noexcept {
+    return !(*this == other);
+  }
+};
+
+} // namespace core
@@ -1,4 +1,5 @@
 #pragma once
+#include "core/EntityId.hpp"
 #include "core/Position.hpp"
 #include <cstdint>
 #include <string>
@@ -19,10 +20,10 @@ enum class EventPriority : std::uint8_t {
 struct EntityDiedEvent {
   static constexpr EventPriority priority = EventPriority::Immediate;
 
-  int entity_id;
+  EntityId entity_id;
   std::string name;
   Position position;
-  int killer_id;              // -1 if environmental damage or no killer
+  EntityId killer_id;         // invalid if environmental damage or no killer
   std::string cause_of_death; // "goblin", "lava", "starvation", etc.
 };
 
@@ -30,8 +31,8 @@ struct EntityDiedEvent {
 struct EntityDamagedEvent {
   static constexpr EventPriority priority = EventPriority::High;
 
-  int entity_id;
-  int attacker_id; // -1 if environmental damage
+  EntityId entity_id;
+  EntityId attacker_id; // invalid if environmental damage
   int damage;
   int remaining_hp;
   std::string damage_type; // "physical", "fire", "poison", "acid", etc.
@@ -41,7 +42,7 @@ struct EntityDamagedEvent {
 struct EntityMovedEvent {
   static constexpr EventPriority priority = EventPriority::Normal;
 
-  int entity_id;
+  EntityId entity_id;
   Position from;
   Position to;
 };
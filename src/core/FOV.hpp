@@ -1,25 +1,332 @@
 #pragma once
+#include "BitGrid.hpp"
 #include "IMapView.hpp"
+#include "MapView.hpp"
 #include "Position.hpp"
-#include <vector>
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 
 namespace core {
 
-class FOV {
+// Visibility algorithm used by FOV::compute()
+enum class FOVAlgorithm : std::uint8_t {
+  Bresenham,    // one ray per target cell, O(r^3) per compute
+  Shadowcasting // symmetric recursive shadowcasting, each cell visited once
+};
+
+// Field of view over any MapView. The view is held by reference and its
+// type is a template parameter, so BasicFOV<world::Map> or
+// BasicFOV<OpacityBitsView> inline the opacity test into the octant scan;
+// FOV (= BasicFOV<IMapView>) keeps the virtual interface for tests and
+// adapters.
+// compute() remembers its inputs and the view's sight revision: asked
+// again for the same origin and radius, it keeps the current visible set
+// unless the view reports a sight edit inside the radius window (a door
+// toggled elsewhere does not count). Idle viewers cost a few compares.
+template <MapView View> class BasicFOV {
 public:
-  explicit FOV(const core::IMapView &map);
+  explicit BasicFOV(const View &map,
+                    FOVAlgorithm algorithm = FOVAlgorithm::Shadowcasting);
 
   void compute(const Position &origin, int radius);
+
+  // Forces the next compute() to run in full (view edited untracked)
+  void invalidate() noexcept { cached_ = false; }
   bool isVisible(int x, int y) const;
 
+  // Bulk access: calls fn(x, y) for each visible cell, row-major.
+  // Only the last compute() window is walked, one word at a time.
+  template <typename Fn> void forEachVisible(Fn &&fn) const {
+    visible_.forEachSetInRect(dirtyMinX_, dirtyMinY_, dirtyMaxX_, dirtyMaxY_,
+                              fn);
+  }
+
+  // Same, restricted to inclusive rectangle (e.g. camera viewport)
+  template <typename Fn>
+  void forEachVisibleInRect(int x0, int y0, int x1, int y1, Fn &&fn) const {
+    visible_.forEachSetInRect(std::max(x0, dirtyMinX_),
+                              std::max(y0, dirtyMinY_),
+                              std::min(x1, dirtyMaxX_),
+                              std::min(y1, dirtyMaxY_), fn);
+  }
+
+  // Raw visibility bits (map-sized, row-padded 64-bit words)
+  const BitGrid &visibleBits() const noexcept { return visible_; }
+
+  // Inclusive window of the last compute(); no bit is set outside it
+  // (empty when x0 > x1)
+  void lastWindow(int &x0, int &y0, int &x1, int &y1) const noexcept {
+    x0 = dirtyMinX_;
+    y0 = dirtyMinY_;
+    x1 = dirtyMaxX_;
+    y1 = dirtyMaxY_;
+  }
+
+  FOVAlgorithm algorithm() const noexcept { return algorithm_; }
+  void setAlgorithm(FOVAlgorithm algorithm) noexcept {
+    algorithm_ = algorithm;
+    cached_ = false;
+  }
+
 private:
-  const core::IMapView &map_;
-  size_t width_;
-  size_t height_;
-  std::vector<std::vector<bool>> visible_;
+  // Slope as exact fraction num/den (den > 0), avoids float rounding at
+  // tile edges
+  struct Slope {
+    int num;
+    int den;
+  };
+
+  const View &map_;
+  std::size_t width_;
+  std::size_t height_;
+  BitGrid visible_;
+  FOVAlgorithm algorithm_;
+
+  // Bounding box touched by last compute(), cleared on next one
+  // (empty when min > max)
+  int dirtyMinX_ = 0;
+  int dirtyMinY_ = 0;
+  int dirtyMaxX_ = -1;
+  int dirtyMaxY_ = -1;
+
+  // Inputs of the current visible set, valid when cached_
+  bool cached_ = false;
+  Position lastOrigin_;
+  int lastRadius_ = 0;
+  std::uint64_t lastRevision_ = 0;
+
+  // True if the current visible set already answers compute(origin,
+  // radius); refreshes the stored revision either way
+  bool upToDate(const Position &origin, int radius) noexcept;
+
+  void computeBresenham(const Position &origin, int radius);
+  void computeShadowcasting(const Position &origin, int radius);
+
+  // Scans one octant row by row; (xx, xy, yx, yy) maps (row, col) to map
+  // offsets from origin
+  void castOctant(const Position &origin, int radius, int row, Slope start,
+                  Slope end, int xx, int xy, int yx, int yy);
 
   // Simple Bresenham line-of-sight check
   bool hasLineOfSight(int x0, int y0, int x1, int y1) const;
   void markRayUntilBlocked(int x0, int y0, int x1, int y1);
 };
+
+using FOV = BasicFOV<IMapView>;
+
+namespace detail {
+
+// Octant transforms: (xx, xy, yx, yy) maps (row, col) to (dx, dy)
+inline constexpr int FOV_OCTANTS[8][4] = {
+    {1, 0, 0, 1},   {0, 1, 1, 0},   {0, -1, 1, 0}, {-1, 0, 0, 1},
+    {-1, 0, 0, -1}, {0, -1, -1, 0}, {0, 1, -1, 0}, {1, 0, 0, -1}};
+
+} // namespace detail
+
+template <MapView View>
+BasicFOV<View>::BasicFOV(const View &map, FOVAlgorithm algorithm)
+    : map_(map), width_(static_cast<std::size_t>(map.width())),
+      height_(static_cast<std::size_t>(map.height())),
+      visible_(map.width(), map.height()), algorithm_(algorithm) {}
+
+template <MapView View>
+bool BasicFOV<View>::upToDate(const Position &origin, int radius) noexcept {
+  if constexpr (SightTrackingView<View>) {
+    const std::uint64_t revision = map_.sightRevision();
+    const bool same = cached_ && origin == lastOrigin_ &&
+                      radius == lastRadius_ &&
+                      !map_.sightChangedSince(lastRevision_, dirtyMinX_,
+                                              dirtyMinY_, dirtyMaxX_,
+                                              dirtyMaxY_);
+    lastRevision_ = revision;
+    return same;
+  } else {
+    return false;
+  }
+}
+
+template <MapView View>
+void BasicFOV<View>::compute(const Position &origin, int radius) {
+  if (upToDate(origin, radius))
+    return;
+  cached_ = true;
+  lastOrigin_ = origin;
+  lastRadius_ = radius;
+
+  ProfileScope profile(ProfileBucket::FOV);
+
+  // Only the previous radius window can hold set bits
+  visible_.clearRect(dirtyMinX_, dirtyMinY_, dirtyMaxX_, dirtyMaxY_);
+  dirtyMinX_ = std::max(0, origin.x - radius);
+  dirtyMinY_ = std::max(0, origin.y - radius);
+  dirtyMaxX_ = std::min(static_cast<int>(width_) - 1, origin.x + radius);
+  dirtyMaxY_ = std::min(static_cast<int>(height_) - 1, origin.y + radius);
+
+  visible_.set(origin.x, origin.y);
+
+  if (algorithm_ == FOVAlgorithm::Shadowcasting)
+    computeShadowcasting(origin, radius);
+  else
+    computeBresenham(origin, radius);
+}
+
+template <MapView View>
+void BasicFOV<View>::computeShadowcasting(const Position &origin, int radius) {
+  for (const auto &o : detail::FOV_OCTANTS)
+    castOctant(origin, radius, 1, Slope{0, 1}, Slope{1, 1}, o[0], o[1], o[2],
+               o[3]);
+}
+
+// Symmetric shadowcasting (see Albert Ford, "Symmetric Shadowcasting"):
+// floor tiles are lit only if their centre lies inside the visible slopes,
+// walls are lit if any part is inside - so A sees B iff B sees A.
+template <MapView View>
+void BasicFOV<View>::castOctant(const Position &origin, int radius, int row,
+                                Slope start, Slope end, int xx, int xy,
+                                int yx, int yy) {
+  if (row > radius)
+    return;
+
+  // Columns whose [col - 1/2, col + 1/2] span overlaps [start, end]
+  // (round half up for start, half down for end)
+  const int minCol = (2 * row * start.num + start.den) / (2 * start.den);
+  const int maxCol =
+      (2 * row * end.num - end.den + 2 * end.den - 1) / (2 * end.den);
+
+  bool first = true;
+  bool prevWall = false;
+  for (int col = minCol; col <= maxCol; ++col) {
+    const int x = origin.x + col * xx + row * xy;
+    const int y = origin.y + col * yx + row * yy;
+    const bool inside = x >= 0 && static_cast<std::size_t>(x) < width_ &&
+                        y >= 0 && static_cast<std::size_t>(y) < height_;
+    // Outside of map behaves like a wall
+    const bool wall = !inside || map_.blocksLineOfSight(x, y);
+
+    const bool symmetric = col * start.den >= row * start.num &&
+                           col * end.den <= row * end.num;
+    if (inside && (wall || symmetric))
+      visible_.set(x, y);
+
+    if (!first && prevWall && !wall)
+      start = Slope{2 * col - 1, 2 * row};
+    if (!first && !prevWall && wall)
+      castOctant(origin, radius, row + 1, start, Slope{2 * col - 1, 2 * row},
+                 xx, xy, yx, yy);
+
+    prevWall = wall;
+    first = false;
+  }
+
+  if (!first && !prevWall)
+    castOctant(origin, radius, row + 1, start, end, xx, xy, yx, yy);
+}
+
+template <MapView View>
+void BasicFOV<View>::computeBresenham(const Position &origin, int radius) {
+  for (int dy = -radius; dy <= radius; ++dy) {
+    for (int dx = -radius; dx <= radius; ++dx) {
+      if (std::max(std::abs(dx), std::abs(dy)) > radius)
+        continue;
+
+      int x = origin.x + dx;
+      int y = origin.y + dy;
+
+      if (x < 0 || static_cast<std::size_t>(x) >= width_ || y < 0 ||
+          static_cast<std::size_t>(y) >= height_)
+        continue;
+
+      // NEW: Mark all tiles along the ray until first blocker
+      markRayUntilBlocked(origin.x, origin.y, x, y);
+    }
+  }
+}
+
+template <MapView View> bool BasicFOV<View>::isVisible(int x, int y) const {
+  if (x < 0 || static_cast<std::size_t>(x) >= width_ || y < 0 ||
+      static_cast<std::size_t>(y) >= height_)
+    return false;
+  return visible_.test(x, y);
+}
+
+template <MapView View>
+bool BasicFOV<View>::hasLineOfSight(int x0, int y0, int x1, int y1) const {
+  // Bresenham's line algorithm for LOS check
+  int dx = std::abs(x1 - x0);
+  int dy = std::abs(y1 - y0);
+  int sx = x0 < x1 ? 1 : -1;
+  int sy = y0 < y1 ? 1 : -1;
+  int err = dx - dy;
+
+  int x = x0;
+  int y = y0;
+
+  while (true) {
+    // Don't check blocking at the target position
+    if (x == x1 && y == y1)
+      return true;
+
+    // Check if current position blocks LOS
+    if (map_.blocksLineOfSight(x, y))
+      return false;
+
+    if (x == x1 && y == y1)
+      break;
+
+    int e2 = 2 * err;
+    if (e2 > -dy) {
+      err -= dy;
+      x += sx;
+    }
+    if (e2 < dx) {
+      err += dx;
+      y += sy;
+    }
+  }
+
+  return true;
+}
+
+template <MapView View>
+void BasicFOV<View>::markRayUntilBlocked(int x0, int y0, int x1, int y1) {
+  // Bresenham - mark all tiles until we hit a blocker
+  int dx = std::abs(x1 - x0);
+  int dy = std::abs(y1 - y0);
+  int sx = x0 < x1 ? 1 : -1;
+  int sy = y0 < y1 ? 1 : -1;
+  int err = dx - dy;
+  int x = x0;
+  int y = y0;
+
+  while (true) {
+    // Mark current tile as visible
+    visible_.set(x, y);
+
+    // If this tile blocks, stop here
+    if (map_.blocksLineOfSight(x, y))
+      return;
+
+    // Reached target
+    if (x == x1 && y == y1)
+      return;
+
+    // Bresenham step
+    int e2 = 2 * err;
+    if (e2 > -dy) {
+      err -= dy;
+      x += sx;
+    }
+    if (e2 < dx) {
+      err += dx;
+      y += sy;
+    }
+  }
+}
+
+// The virtual instantiation is compiled once, in FOV.cpp
+extern template class BasicFOV<IMapView>;
+
 } // namespace core
@@ -1,5 +1,6 @@
 #pragma once
 #include "Position.hpp"
+#include <cstdint>
 
 namespace core {
 struct IMapView {
@@ -8,5 +9,13 @@ struct IMapView {
   virtual int height() const noexcept = 0;
   // True jeśli BLOKUJE LOS:
   virtual bool blocksLineOfSight(int x, int y) const noexcept = 0;
+
+  // Optional sight change tracking (see core::EditLog). The defaults
+  // report "maybe changed", so views without it are always recomputed.
+  virtual std::uint64_t sightRevision() const noexcept { return 0; }
+  virtual bool sightChangedSince(std::uint64_t, int, int, int,
+                                 int) const noexcept {
+    return true;
+  }
 };
 } // namespace core
@@ -0,0 +1,61 @@
+#pragma once
+#include "BitGrid.hpp"
+#include <concepts>
+#include <cstdint>
+
+namespace core {
+
+// Anything FOV / Pathfinding can read: dimensions plus an opacity test.
+// blocksLineOfSight(x, y) is only called for in-bounds cells.
+// Satisfied by IMapView (virtual), world::Map and OpacityBitsView; the
+// template algorithms instantiated on a concrete type inline the test.
+template <typename View>
+concept MapView = requires(const View &view, int x, int y) {
+  { view.width() } -> std::convertible_to<int>;
+  { view.height() } -> std::convertible_to<int>;
+  { view.blocksLineOfSight(x, y) } -> std::convertible_to<bool>;
+};
+
+// Views that also tell movement apart from sight (e.g. world::LevelView)
+template <typename View>
+concept MovementView =
+    MapView<View> && requires(const View &view, int x, int y) {
+      { view.blocksMovement(x, y) } -> std::convertible_to<bool>;
+    };
+
+// Views that report sight edits: sightRevision() is a counter,
+// sightChangedSince(rev, x0, y0, x1, y1) whether a cell of the inclusive
+// rectangle may have changed blocksLineOfSight() after rev
+template <typename View>
+concept SightTrackingView =
+    MapView<View> && requires(const View &view, std::uint64_t rev, int x) {
+      { view.sightRevision() } -> std::convertible_to<std::uint64_t>;
+      { view.sightChangedSince(rev, x, x, x, x) } -> std::convertible_to<bool>;
+    };
+
+// Movement test used by pathfinding: the view's own blocksMovement() when
+// it has one, otherwise opacity (walls block both)
+template <MapView View>
+bool viewBlocksMovement(const View &view, int x, int y) noexcept {
+  if constexpr (MovementView<View>)
+    return view.blocksMovement(x, y);
+  else
+    return view.blocksLineOfSight(x, y);
+}
+
+// Raw opacity bitmap as a map view (set bit = blocks line of sight)
+class OpacityBitsView {
+public:
+  explicit OpacityBitsView(const BitGrid &bits) noexcept : bits_(bits) {}
+
+  int width() const noexcept { return bits_.width(); }
+  int height() const noexcept { return bits_.height(); }
+  bool blocksLineOfSight(int x, int y) const noexcept {
+    return bits_.test(x, y);
+  }
+
+private:
+  const BitGrid &bits_;
+};
+
+} // namespace core
@@ -1,26 +1,191 @@
 #pragma once
 #include "IMapView.hpp"
+#include "MapView.hpp"
 #include "Position.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
 #include <vector>
 
 namespace core {
 
-class Pathfinding {
+// A* over flat W*H node arrays reused between queries.
+// Nodes are stamped with a per-query generation instead of being cleared,
+// so a search only touches the cells it actually expands.
+// Templated on the map view like BasicFOV; Pathfinding is the IMapView
+// (virtual) instantiation. Cells are walkable unless viewBlocksMovement().
+template <MapView View> class BasicPathfinding {
 public:
-  explicit Pathfinding(const IMapView &map);
+  explicit BasicPathfinding(const View &map);
 
   // Finds path from start to goal using A*
   // Returns empty vector if no path exists
   std::vector<Position> findPath(const Position &start, const Position &goal);
 
 private:
-  const IMapView &map_;
+  // Binary heap entry (open set)
+  struct OpenNode {
+    int f;            // f = g + h
+    std::uint32_t id; // y * width + x
+  };
+
+  const View &map_;
+  int width_;
+  int height_;
+
+  // Per-cell search state, valid only when stamp_[id] == generation_
+  std::vector<std::uint32_t> stamp_;
+  std::vector<int> gScore_;
+  std::vector<std::uint32_t> cameFrom_;
+  std::vector<std::uint32_t> closed_; // == generation_ when expanded
+  std::uint32_t generation_;
+
+  std::vector<OpenNode> open_;
 
   // Heuristic: Manhattan distance
   int heuristic(const Position &a, const Position &b) const;
 
-  // Get walkable neighbors (8-directional)
-  std::vector<Position> getNeighbors(const Position &pos) const;
+  // Starts a new query - invalidates all node state in O(1)
+  void beginQuery();
+
+  void pushOpen(int f, std::uint32_t id);
+  OpenNode popOpen();
+
+  // Heap order for the open set: smallest f on top
+  static bool higherF(const OpenNode &a, const OpenNode &b) noexcept {
+    return a.f > b.f;
+  }
 };
 
+using Pathfinding = BasicPathfinding<IMapView>;
+
+namespace detail {
+
+// 8 directions: N, NE, E, SE, S, SW, W, NW
+inline constexpr int PATH_DX[] = {0, 1, 1, 1, 0, -1, -1, -1};
+inline constexpr int PATH_DY[] = {-1, -1, 0, 1, 1, 1, 0, -1};
+
+} // namespace detail
+
+template <MapView View>
+BasicPathfinding<View>::BasicPathfinding(const View &map)
+    : map_(map), width_(map.width()), height_(map.height()), generation_(0) {
+  const std::size_t cells =
+      static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_);
+  stamp_.assign(cells, 0);
+  gScore_.assign(cells, 0);
+  cameFrom_.assign(cells, 0);
+  closed_.assign(cells, 0);
+}
+
+template <MapView View>
+int BasicPathfinding<View>::heuristic(const Position &a,
+                                      const Position &b) const {
+  return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+template <MapView View> void BasicPathfinding<View>::beginQuery() {
+  open_.clear();
+  if (++generation_ == 0) {
+    // Stamp counter wrapped - old stamps could alias, reset once
+    std::fill(stamp_.begin(), stamp_.end(), 0);
+    std::fill(closed_.begin(), closed_.end(), 0);
+    generation_ = 1;
+  }
+}
+
+// Min-heap on f, kept in a plain vector reused across queries
+template <MapView View>
+void BasicPathfinding<View>::pushOpen(int f, std::uint32_t id) {
+  open_.push_back({f, id});
+  std::push_heap(open_.begin(), open_.end(), higherF);
+}
+
+template <MapView View>
+typename BasicPathfinding<View>::OpenNode BasicPathfinding<View>::popOpen() {
+  std::pop_heap(open_.begin(), open_.end(), higherF);
+  OpenNode top = open_.back();
+  open_.pop_back();
+  return top;
+}
+
+template <MapView View>
+std::vector<Position>
+BasicPathfinding<View>::findPath(const Position &start, const Position &goal) {
+  ProfileScope profile(ProfileBucket::Pathfinding);
+
+  if (start == goal)
+    return {start};
+
+  auto inBounds = [this](int x, int y) {
+    return x >= 0 && x < width_ && y >= 0 && y < height_;
+  };
+  if (!inBounds(start.x, start.y) || !inBounds(goal.x, goal.y))
+    return {};
+
+  if (viewBlocksMovement(map_, goal.x, goal.y))
+    return {};
+
+  beginQuery();
+
+  auto toId = [this](int x, int y) {
+    return static_cast<std::uint32_t>(y * width_ + x);
+  };
+  const std::uint32_t startId = toId(start.x, start.y);
+  const std::uint32_t goalId = toId(goal.x, goal.y);
+
+  stamp_[startId] = generation_;
+  gScore_[startId] = 0;
+  pushOpen(heuristic(start, goal), startId);
+
+  while (!open_.empty()) {
+    const std::uint32_t current = popOpen().id;
+
+    if (current == goalId) {
+      // Reconstruct path
+      std::vector<Position> path;
+      for (std::uint32_t id = goalId; id != startId; id = cameFrom_[id])
+        path.push_back({static_cast<int>(id) % width_,
+                        static_cast<int>(id) / width_});
+      path.push_back(start);
+      std::reverse(path.begin(), path.end());
+      return path;
+    }
+
+    if (closed_[current] == generation_)
+      continue;
+    closed_[current] = generation_;
+
+    const int cx = static_cast<int>(current) % width_;
+    const int cy = static_cast<int>(current) / width_;
+    const int tentativeG = gScore_[current] + 1;
+
+    // Walkable neighbors, expanded inline
+    for (int i = 0; i < 8; ++i) {
+      const int nx = cx + detail::PATH_DX[i];
+      const int ny = cy + detail::PATH_DY[i];
+      if (!inBounds(nx, ny) || viewBlocksMovement(map_, nx, ny))
+        continue;
+
+      const std::uint32_t neighbor = toId(nx, ny);
+      if (closed_[neighbor] == generation_)
+        continue;
+
+      if (stamp_[neighbor] != generation_ || tentativeG < gScore_[neighbor]) {
+        stamp_[neighbor] = generation_;
+        gScore_[neighbor] = tentativeG;
+        cameFrom_[neighbor] = current;
+        pushOpen(tentativeG + heuristic({nx, ny}, goal), neighbor);
+      }
+    }
+  }
+
+  return {}; // No path found
+}
+
+// The virtual instantiation is compiled once, in Pathfinding.cpp
+extern template class BasicPathfinding<IMapView>;
+
 } // namespace core
@@ -0,0 +1,32 @@
+#include "Profiler.hpp"
+
+namespace core {
+
+std::string_view profileBucketName(ProfileBucket bucket) noexcept {
+  switch (bucket) {
+  case ProfileBucket::FOV:
+    return "FOV";
+  case ProfileBucket::Pathfinding:
+    return "Pathfinding";
+  case ProfileBucket::AI:
+    return "AI";
+  case ProfileBucket::Scheduling:
+    return "Scheduling";
+  case ProfileBucket::Count:
+    break;
+  }
+  return "Unknown";
+}
+
+void Profiler::reset() noexcept {
+  totals_.fill(Clock::duration::zero());
+  calls_.fill(0);
+}
+
+void Profiler::add(ProfileBucket bucket, Clock::duration elapsed) noexcept {
+  const auto i = static_cast<std::size_t>(bucket);
+  totals_[i] += elapsed;
+  ++calls_[i];
+}
+
+} // namespace core
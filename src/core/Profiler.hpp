@@ -0,0 +1,72 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace core {
+
+// Subsystems timed by the profiler
+enum class ProfileBucket : std::uint8_t {
+  FOV,
+  Pathfinding, // A* and distance maps
+  AI,          // whole AIBehavior::act(), includes nested FOV/Pathfinding
+  Scheduling,  // TurnManager
+  Count
+};
+
+inline constexpr std::size_t PROFILE_BUCKET_COUNT =
+    static_cast<std::size_t>(ProfileBucket::Count);
+
+std::string_view profileBucketName(ProfileBucket bucket) noexcept;
+
+// Process-wide accumulating timers, off by default.
+// When disabled a ProfileScope costs one branch; when enabled two clock
+// reads. Not thread-safe - meant for the single-threaded game loop.
+class Profiler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static void setEnabled(bool enabled) noexcept { enabled_ = enabled; }
+  static bool enabled() noexcept { return enabled_; }
+
+  static void reset() noexcept;
+  static void add(ProfileBucket bucket, Clock::duration elapsed) noexcept;
+
+  static Clock::duration total(ProfileBucket bucket) noexcept {
+    return totals_[static_cast<std::size_t>(bucket)];
+  }
+  static std::uint64_t calls(ProfileBucket bucket) noexcept {
+    return calls_[static_cast<std::size_t>(bucket)];
+  }
+
+private:
+  static inline bool enabled_ = false;
+  static inline std::array<Clock::duration, PROFILE_BUCKET_COUNT> totals_{};
+  static inline std::array<std::uint64_t, PROFILE_BUCKET_COUNT> calls_{};
+};
+
+// Times the enclosing scope into a bucket (if profiling is enabled)
+class ProfileScope {
+public:
+  explicit ProfileScope(ProfileBucket bucket) noexcept
+      : bucket_(bucket), active_(Profiler::enabled()) {
+    if (active_)
+      start_ = Profiler::Clock::now();
+  }
+  ~ProfileScope() {
+    if (active_)
+      Profiler::add(bucket_, Profiler::Clock::now() - start_);
+  }
+
+  ProfileScope(const ProfileScope &) = delete;
+  ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+  ProfileBucket bucket_;
+  bool active_;
+  Profiler::Clock::time_point start_;
+};
+
+} // namespace core
@@ -0,0 +1,148 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <string_view>
+#include <utility>
+
+namespace core {
+
+// Counter-based random number generator (Philox4x32-10).
+// Output i of a generator is a pure function of (key, i), so:
+// - fork(name) / stream(id) derive independent generators from the key
+//   alone, no matter how many numbers the parent has already drawn
+// - discard(n) is O(1)
+// - work split across threads by sub-stream gives the same numbers as
+//   running it serially
+// Satisfies UniformRandomBitGenerator, but prefer the helpers below over
+// std::*_distribution: their algorithms are fixed here, so results do not
+// depend on the standard library implementation.
+class Rng {
+public:
+  using result_type = std::uint64_t;
+  using Block = std::array<std::uint32_t, 4>;
+
+  explicit Rng(std::uint64_t seed = 0) noexcept : key_(seed) {}
+
+  static constexpr result_type min() noexcept { return 0; }
+  static constexpr result_type max() noexcept {
+    return std::numeric_limits<result_type>::max();
+  }
+
+  // Next 64 random bits (two outputs per Philox block)
+  result_type operator()() noexcept {
+    if ((index_ & 1) == 0)
+      refill();
+    return buffer_[index_++ & 1];
+  }
+
+  // Skips n outputs
+  void discard(std::uint64_t n) noexcept {
+    index_ += n;
+    if ((index_ & 1) != 0)
+      refill(); // mid-block: second half must come from the new block
+  }
+
+  // Independent child generator for a named purpose (e.g. "terrain")
+  Rng fork(std::string_view name) const noexcept {
+    std::uint64_t h = 0xCBF29CE484222325ull; // FNV-1a
+    for (char c : name)
+      h = (h ^ static_cast<unsigned char>(c)) * 0x100000001B3ull;
+    return derive(1, h);
+  }
+
+  // Independent child generator for a numbered purpose (e.g. a depth)
+  Rng stream(std::uint64_t id) const noexcept { return derive(2, id); }
+
+  // Uniform integer in [lo, hi], unbiased (rejection on the low range)
+  int uniformInt(int lo, int hi) noexcept {
+    const std::uint64_t range =
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(hi) - lo) + 1;
+    return static_cast<int>(static_cast<std::int64_t>(lo) +
+                            static_cast<std::int64_t>(below(range)));
+  }
+
+  // Uniform index in [0, n), n > 0
+  std::size_t uniformIndex(std::size_t n) noexcept {
+    return static_cast<std::size_t>(below(n));
+  }
+
+  // Uniform double in [0, 1) with 53 random bits
+  double uniformReal() noexcept {
+    return static_cast<double>((*this)() >> 11) * 0x1.0p-53;
+  }
+
+  bool chance(double probability) noexcept {
+    return uniformReal() < probability;
+  }
+
+  // Fisher-Yates shuffle (fixed algorithm, unlike std::shuffle)
+  template <typename RandomIt> void shuffle(RandomIt first, RandomIt last) {
+    const auto n = static_cast<std::size_t>(std::distance(first, last));
+    for (std::size_t i = n; i > 1; --i) {
+      using std::swap;
+      swap(first[static_cast<std::ptrdiff_t>(i - 1)],
+           first[static_cast<std::ptrdiff_t>(uniformIndex(i))]);
+    }
+  }
+
+  // The raw block function: ten Philox rounds of counter under key
+  static Block philox(Block counter, std::uint64_t key) noexcept {
+    std::uint32_t k0 = static_cast<std::uint32_t>(key);
+    std::uint32_t k1 = static_cast<std::uint32_t>(key >> 32);
+    for (int round = 0; round < 10; ++round) {
+      if (round > 0) {
+        k0 += 0x9E3779B9u;
+        k1 += 0xBB67AE85u;
+      }
+      const std::uint64_t p0 = std::uint64_t{0xD2511F53u} * counter[0];
+      const std::uint64_t p1 = std::uint64_t{0xCD9E8D57u} * counter[2];
+      counter = {static_cast<std::uint32_t>(p1 >> 32) ^ counter[1] ^ k0,
+                 static_cast<std::uint32_t>(p1),
+                 static_cast<std::uint32_t>(p0 >> 32) ^ counter[3] ^ k1,
+                 static_cast<std::uint32_t>(p0)};
+    }
+    return counter;
+  }
+
+private:
+  // Uniform value in [0, range), range > 0; 0 means the full 2^64 range
+  std::uint64_t below(std::uint64_t range) noexcept {
+    if (range == 0)
+      return (*this)();
+    // Reject the lowest 2^64 mod range values so every residue is equally
+    // likely
+    const std::uint64_t threshold = (std::uint64_t{0} - range) % range;
+    for (;;) {
+      const std::uint64_t x = (*this)();
+      if (x >= threshold)
+        return x % range;
+    }
+  }
+
+  void refill() noexcept {
+    const std::uint64_t block = index_ >> 1;
+    const Block out = philox({static_cast<std::uint32_t>(block),
+                              static_cast<std::uint32_t>(block >> 32), 0, 0},
+                             key_);
+    buffer_[0] = (std::uint64_t{out[1]} << 32) | out[0];
+    buffer_[1] = (std::uint64_t{out[3]} << 32) | out[2];
+  }
+
+  // Child key: one block of (tag, value) under the parent key, in a
+  // counter range ordinary draws never reach (word 2 = tag != 0)
+  Rng derive(std::uint32_t tag, std::uint64_t value) const noexcept {
+    const Block out = philox({static_cast<std::uint32_t>(value),
+                              static_cast<std::uint32_t>(value >> 32), tag, 0},
+                             key_);
+    return Rng((std::uint64_t{out[1]} << 32) | out[0]);
+  }
+
+  std::uint64_t key_;
+  std::uint64_t index_ = 0; // outputs drawn so far
+  std::array<std::uint64_t, 2> buffer_{};
+};
+
+} // namespace core
@@ -0,0 +1,52 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace core {
+
+// Fixed set of worker threads consuming one FIFO task queue.
+// submit() returns a future for the task's result; exceptions thrown by
+// the task are delivered through it. The destructor runs the tasks still
+// queued, then joins - callers cancel long work through their own flags.
+class ThreadPool {
+public:
+  // threads == 0 picks hardware_concurrency() (at least one worker)
+  explicit ThreadPool(std::size_t threads = 0);
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  std::size_t size() const noexcept { return workers_.size(); }
+
+  template <typename Fn>
+  std::future<std::invoke_result_t<std::decay_t<Fn>>> submit(Fn &&fn) {
+    using Result = std::invoke_result_t<std::decay_t<Fn>>;
+    // std::function needs a copyable target, packaged_task is move-only
+    auto task = std::make_shared<std::packaged_task<Result()>>(
+        std::forward<Fn>(fn));
+    std::future<Result> result = task->get_future();
+    post([task] { (*task)(); });
+    return result;
+  }
+
+private:
+  void post(std::function<void()> task);
+  void workerLoop();
+
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<std::function<void()>> tasks_;
+  bool stopping_ = false;
+  std::vector<std::thread> workers_;
+};
+
+} // namespace core
@@ -0,0 +1,90 @@
+#include "ActorStore.hpp"
+
+namespace entities {
+
+core::EntityId ActorStore::create(ComponentMask mask) {
+  std::uint32_t slot;
+  if (!freeSlots_.empty()) {
+    slot = freeSlots_.back();
+    freeSlots_.pop_back();
+  } else {
+    slot = static_cast<std::uint32_t>(slots_.size());
+    slots_.push_back({});
+    freeSlots_.reserve(slots_.size());
+  }
+  slots_[slot].dense = static_cast<std::uint32_t>(ids_.size());
+
+  const core::EntityId id{slot, slots_[slot].generation};
+  ids_.push_back(id);
+  masks_.push_back(mask);
+  positions_.push_back({});
+  hp_.push_back(0);
+  maxHp_.push_back(0);
+  speed_.push_back(0);
+  energy_.push_back(0);
+  glyphs_.push_back(' ');
+  return id;
+}
+
+void ActorStore::destroy(core::EntityId id) {
+  if (!alive(id))
+    return;
+
+  const std::size_t i = slots_[id.index].dense;
+  const std::size_t last = ids_.size() - 1;
+  if (i != last) {
+    ids_[i] = ids_[last];
+    masks_[i] = masks_[last];
+    positions_[i] = positions_[last];
+    hp_[i] = hp_[last];
+    maxHp_[i] = maxHp_[last];
+    speed_[i] = speed_[last];
+    energy_[i] = energy_[last];
+    glyphs_[i] = glyphs_[last];
+    slots_[ids_[i].index].dense = static_cast<std::uint32_t>(i);
+  }
+  ids_.pop_back();
+  masks_.pop_back();
+  positions_.pop_back();
+  hp_.pop_back();
+  maxHp_.pop_back();
+  speed_.pop_back();
+  energy_.pop_back();
+  glyphs_.pop_back();
+
+  ++slots_[id.index].generation;
+  freeSlots_.push_back(id.index);
+}
+
+bool ActorStore::alive(core::EntityId id) const noexcept {
+  return id.index < slots_.size() &&
+         slots_[id.index].generation == id.generation;
+}
+
+void ActorStore::reserve(std::size_t n) {
+  ids_.reserve(n);
+  masks_.reserve(n);
+  positions_.reserve(n);
+  hp_.reserve(n);
+  maxHp_.reserve(n);
+  speed_.reserve(n);
+  energy_.reserve(n);
+  glyphs_.reserve(n);
+}
+
+void ActorStore::clear() noexcept {
+  for (const core::EntityId &id : ids_) {
+    ++slots_[id.index].generation;
+    freeSlots_.push_back(id.index);
+  }
+  ids_.clear();
+  masks_.clear();
+  positions_.clear();
+  hp_.clear();
+  maxHp_.clear();
+  speed_.clear();
+  energy_.clear();
+  glyphs_.clear();
+}
+
+} // namespace entities
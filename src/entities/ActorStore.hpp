@@ -0,0 +1,93 @@
+#pragma once
+#include "core/EntityId.hpp"
+#include "core/Position.hpp"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace entities {
+
+// Component bits of an actor in ActorStore
+enum Component : std::uint8_t {
+  CPosition = 1u << 0,
+  CHealth = 1u << 1, // hp + max hp
+  CSpeed = 1u << 2,  // speed + energy
+  CGlyph = 1u << 3,
+};
+using ComponentMask = std::uint8_t;
+
+// Struct-of-arrays storage for lightweight actors (bulk simulation).
+// Every component is one contiguous array indexed by dense actor index,
+// so systems run as straight loops over the arrays they need.
+// Lives next to EntityManager: heavy entities (player, scripted AI) stay
+// Entity objects, crowds of simple monsters go here.
+// Handles are generational like EntityManager's; destroy() swaps the last
+// actor into the hole, so dense indexes are only valid until then.
+class ActorStore {
+public:
+  ActorStore() = default;
+
+  // New actor with given components (zero/default initialized)
+  core::EntityId create(ComponentMask mask);
+  void destroy(core::EntityId id);
+
+  bool alive(core::EntityId id) const noexcept;
+  std::size_t size() const noexcept { return ids_.size(); }
+  void reserve(std::size_t n);
+  void clear() noexcept;
+
+  // Dense index of a live actor (valid until the next destroy())
+  std::size_t indexOf(core::EntityId id) const noexcept {
+    assert(alive(id)); // a stale id would alias another actor's index
+    return slots_[id.index].dense;
+  }
+
+  // Component arrays, parallel, size() long
+  std::span<const core::EntityId> ids() const noexcept { return ids_; }
+  std::span<ComponentMask> masks() noexcept { return masks_; }
+  std::span<const ComponentMask> masks() const noexcept { return masks_; }
+  std::span<core::Position> positions() noexcept { return positions_; }
+  std::span<const core::Position> positions() const noexcept {
+    return positions_;
+  }
+  std::span<int> hp() noexcept { return hp_; }
+  std::span<const int> hp() const noexcept { return hp_; }
+  std::span<int> maxHp() noexcept { return maxHp_; }
+  std::span<const int> maxHp() const noexcept { return maxHp_; }
+  std::span<int> speed() noexcept { return speed_; }
+  std::span<const int> speed() const noexcept { return speed_; }
+  std::span<int> energy() noexcept { return energy_; }
+  std::span<const int> energy() const noexcept { return energy_; }
+  std::span<char> glyphs() noexcept { return glyphs_; }
+  std::span<const char> glyphs() const noexcept { return glyphs_; }
+
+  // Calls fn(i) for every dense index whose mask has all required bits
+  template <typename Fn> void each(ComponentMask required, Fn &&fn) const {
+    const std::size_t n = masks_.size();
+    for (std::size_t i = 0; i < n; ++i) {
+      if ((masks_[i] & required) == required)
+        fn(i);
+    }
+  }
+
+private:
+  struct Slot {
+    std::uint32_t generation = 0;
+    std::uint32_t dense = 0;
+  };
+  std::vector<Slot> slots_;
+  std::vector<std::uint32_t> freeSlots_;
+
+  std::vector<core::EntityId> ids_;
+  std::vector<ComponentMask> masks_;
+  std::vector<core::Position> positions_;
+  std::vector<int> hp_;
+  std::vector<int> maxHp_;
+  std::vector<int> speed_;
+  std::vector<int> energy_;
+  std::vector<char> glyphs_;
+};
+
+} // namespace entities
@@ -1,36 +1,93 @@
 #include "Entity.hpp"
+#include "EntityManager.hpp"
 #include "ai/AIBehavior.hpp"
+#include <cassert>
+#include <utility>
 
 namespace entities {
 
 Entity::Entity(const std::string &name, const core::Position &pos)
     : name_(name), position_(pos), glyph_('@') {
-  properties_["hp"] = 0;
-  properties_["max_hp"] = 0;
+  set(Prop::HP, 0);
+  set(Prop::MaxHP, 0);
+}
+
+Entity::Entity(Entity &&other) noexcept
+    : name_(std::move(other.name_)), position_(other.position_),
+      props_(other.props_), propMask_(other.propMask_),
+      extraProps_(std::move(other.extraProps_)), ai_(std::move(other.ai_)),
+      glyph_(other.glyph_) {
+  assert(other.owner_ == nullptr && "owned entities stay in their pool");
 }
 
 Entity::~Entity() = default;
 
-void Entity::setProperty(const std::string &key, int value) {
-  properties_[key] = value;
+void Entity::setPosition(const core::Position &pos) {
+  const core::Position from = position_;
+  position_ = pos;
+  if (owner_ && from != pos)
+    owner_->onEntityMoved(*this, from);
 }
 
-int Entity::getProperty(const std::string &key, int defaultValue) const {
-  auto it = properties_.find(key);
-  if (it != properties_.end()) {
-    return it->second;
+void Entity::setProperty(std::string_view key, int value) {
+  if (auto prop = propFromName(key)) {
+    set(*prop, value);
+    return;
+  }
+  for (auto &[name, stored] : extraProps_) {
+    if (name == key) {
+      stored = value;
+      changed();
+      return;
+    }
+  }
+  extraProps_.emplace_back(std::string(key), value);
+  changed();
+}
+
+int Entity::getProperty(std::string_view key, int defaultValue) const {
+  if (auto prop = propFromName(key)) {
+    return get(*prop, defaultValue);
+  }
+  for (const auto &[name, stored] : extraProps_) {
+    if (name == key) {
+      return stored;
+    }
   }
   return defaultValue;
 }
 
-bool Entity::hasProperty(const std::string &key) const {
-  return properties_.find(key) != properties_.end();
+bool Entity::hasProperty(std::string_view key) const {
+  if (auto prop = propFromName(key)) {
+    return has(*prop);
+  }
+  for (const auto &entry : extraProps_) {
+    if (entry.first == key) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void Entity::setAI(std::unique_ptr<ai::AIBehavior> ai) {
+  ai_ = std::move(ai);
+  changed();
 }
 
-void Entity::setAI(std::unique_ptr<ai::AIBehavior> ai) { ai_ = std::move(ai); }
+void Entity::notifyOwner() noexcept { ++owner_->revision_; }
 
-const std::unordered_map<std::string, int> &Entity::getAllProperties() const {
-  return properties_;
+std::unordered_map<std::string, int> Entity::getAllProperties() const {
+  std::unordered_map<std::string, int> all;
+  for (std::size_t i = 0; i < PROP_COUNT; ++i) {
+    const Prop prop = static_cast<Prop>(i);
+    if (has(prop)) {
+      all.emplace(std::string(propName(prop)), props_[i]);
+    }
+  }
+  for (const auto &[name, value] : extraProps_) {
+    all.emplace(name, value);
+  }
+  return all;
 }
 
 } // namespace entities
@@ -1,8 +1,15 @@
 #pragma once
+#include "Prop.hpp"
+#include "core/EntityId.hpp"
 #include "core/Position.hpp"
+#include <array>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ai {
 class AIBehavior;
@@ -10,32 +17,58 @@ class AIBehavior;
 
 namespace entities {
 
+class EntityManager;
+
 class Entity {
 public:
   Entity(const std::string &name, const core::Position &pos);
+  // Only unowned entities move (EntityManager::addEntity moves them into
+  // its pool); the moved-to entity starts unowned as well
+  Entity(Entity &&other) noexcept;
+  Entity &operator=(Entity &&) = delete;
   ~Entity();
   // Position management
   const core::Position &getPosition() const noexcept { return position_; }
-  void setPosition(const core::Position &pos) noexcept { position_ = pos; }
+  // Also updates the owning EntityManager's occupancy index
+  void setPosition(const core::Position &pos);
+
+  // Handle assigned by the owning EntityManager (invalid while unowned)
+  core::EntityId getId() const noexcept { return id_; }
 
   // Name
   const std::string &getName() const noexcept { return name_; }
 
   char getGlyph() const { return glyph_; }
-  void setGlyph(char g) { glyph_ = g; }
-  const std::unordered_map<std::string, int> &getAllProperties() const;
+  void setGlyph(char g) {
+    glyph_ = g;
+    changed();
+  }
+  // Snapshot of all properties by string key (serialization)
+  std::unordered_map<std::string, int> getAllProperties() const;
+
+  // Typed stats - fixed slots, no hashing
+  int get(Prop prop, int defaultValue = 0) const noexcept {
+    return has(prop) ? props_[index(prop)] : defaultValue;
+  }
+  void set(Prop prop, int value) noexcept {
+    props_[index(prop)] = value;
+    propMask_ |= bit(prop);
+    changed();
+  }
+  bool has(Prop prop) const noexcept { return (propMask_ & bit(prop)) != 0; }
 
-  // Generic property system
-  void setProperty(const std::string &key, int value);
-  int getProperty(const std::string &key, int defaultValue = 0) const;
-  bool hasProperty(const std::string &key) const;
+  // Generic property system (slow path: known keys map to Prop slots,
+  // anything else lives in a small list)
+  void setProperty(std::string_view key, int value);
+  int getProperty(std::string_view key, int defaultValue = 0) const;
+  bool hasProperty(std::string_view key) const;
 
   // Common property helpers (optional convenience)
-  void setHP(int hp) { setProperty("hp", hp); }
-  int getHP() const { return getProperty("hp", 0); }
+  void setHP(int hp) { set(Prop::HP, hp); }
+  int getHP() const { return get(Prop::HP, 0); }
 
-  void setMaxHP(int maxHp) { setProperty("max_hp", maxHp); }
-  int getMaxHP() const { return getProperty("max_hp", 0); }
+  void setMaxHP(int maxHp) { set(Prop::MaxHP, maxHp); }
+  int getMaxHP() const { return get(Prop::MaxHP, 0); }
 
   // AI
   void setAI(std::unique_ptr<ai::AIBehavior> ai);
@@ -44,11 +77,34 @@ public:
   const ai::AIBehavior *getAI() const { return ai_.get(); }
 
 private:
+  // Bumps the owning EntityManager's revision
+  void changed() noexcept {
+    if (owner_)
+      notifyOwner();
+  }
+  void notifyOwner() noexcept;
+
+  static constexpr std::size_t index(Prop prop) noexcept {
+    return static_cast<std::size_t>(prop);
+  }
+  static constexpr std::uint32_t bit(Prop prop) noexcept {
+    return std::uint32_t{1} << static_cast<unsigned>(prop);
+  }
+
   std::string name_;
   core::Position position_;
-  std::unordered_map<std::string, int> properties_;
+  std::array<int, PROP_COUNT> props_{};
+  std::uint32_t propMask_ = 0; // bit per Prop that has been set
+  // Rare dynamic keys, linear scan (usually empty)
+  std::vector<std::pair<std::string, int>> extraProps_;
   std::unique_ptr<ai::AIBehavior> ai_;
   char glyph_;
+
+  // Set while owned by an EntityManager (occupancy index bookkeeping)
+  friend class EntityManager;
+  EntityManager *owner_ = nullptr;
+  Entity *nextInCell_ = nullptr;
+  core::EntityId id_;
 };
 
 } // namespace entities
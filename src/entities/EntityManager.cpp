@@ -1,39 +1,245 @@
 #include "EntityManager.hpp"
 #include <algorithm>
 #include <memory>
+#include <utility>
 
 namespace entities {
 
-void EntityManager::addEntity(std::unique_ptr<Entity> entity) {
-  entities_.push_back(std::move(entity));
+EntityManager::EntityManager(int width, int height)
+    : gridW_(std::max(width, 0)), gridH_(std::max(height, 0)),
+      cells_(static_cast<std::size_t>(gridW_) *
+                 static_cast<std::size_t>(gridH_),
+             nullptr) {}
+
+EntityManager::EntityManager(EntityManager &&other) noexcept
+    : entities_(std::move(other.entities_)), blocks_(std::move(other.blocks_)),
+      slots_(std::move(other.slots_)), freeSlots_(std::move(other.freeSlots_)), gridW_(other.gridW_),
+      gridH_(other.gridH_), cells_(std::move(other.cells_)),
+      outside_(std::move(other.outside_)), revision_(other.revision_) {
+  other.gridW_ = other.gridH_ = 0;
+  adoptEntities();
+}
+
+EntityManager &EntityManager::operator=(EntityManager &&other) noexcept {
+  if (this != &other) {
+    destroyAll();
+    entities_ = std::move(other.entities_);
+    other.entities_.clear(); // they live in our blocks now
+    blocks_ = std::move(other.blocks_);
+    slots_ = std::move(other.slots_);
+    freeSlots_ = std::move(other.freeSlots_);
+    gridW_ = other.gridW_;
+    gridH_ = other.gridH_;
+    cells_ = std::move(other.cells_);
+    outside_ = std::move(other.outside_);
+    revision_ = std::max(revision_, other.revision_) + 1;
+    other.gridW_ = other.gridH_ = 0;
+    adoptEntities();
+  }
+  return *this;
+}
+
+EntityManager::~EntityManager() { destroyAll(); }
+
+void EntityManager::adoptEntities() noexcept {
+  for (Entity *entity : entities_)
+    entity->owner_ = this;
+}
+
+void EntityManager::destroyAll() noexcept {
+  for (Entity *entity : entities_)
+    std::destroy_at(entity);
+}
+
+Entity &EntityManager::createEntity(const std::string &name,
+                                    const core::Position &pos) {
+  const std::uint32_t slot = acquireSlot();
+  Entity *entity;
+  try {
+    entity = std::construct_at(static_cast<Entity *>(cell(slot)), name, pos);
+  } catch (...) {
+    freeSlots_.push_back(slot);
+    throw;
+  }
+  insert(*entity, slot);
+  return *entity;
+}
+
+core::EntityId EntityManager::addEntity(Entity &&entity) {
+  const std::uint32_t slot = acquireSlot();
+  Entity *stored =
+      std::construct_at(static_cast<Entity *>(cell(slot)), std::move(entity));
+  insert(*stored, slot);
+  return stored->id_;
+}
+
+std::uint32_t EntityManager::acquireSlot() {
+  if (!freeSlots_.empty()) {
+    const std::uint32_t slot = freeSlots_.back();
+    freeSlots_.pop_back();
+    return slot;
+  }
+
+  const auto slot = static_cast<std::uint32_t>(slots_.size());
+  if (slots_.size() == blocks_.size() * BLOCK_SIZE)
+    blocks_.push_back(std::make_unique_for_overwrite<Block>());
+  // Every slot can be freed at once - keeps clear() allocation-free
+  freeSlots_.reserve(slots_.size() + 1);
+  slots_.push_back({});
+  return slot;
+}
+
+void *EntityManager::cell(std::uint32_t slot) const noexcept {
+  return blocks_[slot / BLOCK_SIZE]->cells +
+         (slot % BLOCK_SIZE) * sizeof(Entity);
+}
+
+void EntityManager::insert(Entity &entity, std::uint32_t slot) {
+  slots_[slot].dense = static_cast<std::uint32_t>(entities_.size());
+  entity.id_ = {slot, slots_[slot].generation};
+  entity.owner_ = this;
+  entity.nextInCell_ = nullptr;
+  entities_.push_back(&entity);
+  link(entity);
+  ++revision_;
 }
 
 void EntityManager::removeEntity(Entity *entity) {
-  entities_.erase(std::remove_if(entities_.begin(), entities_.end(),
-                                 [entity](const std::unique_ptr<Entity> &e) {
-                                   return e.get() == entity;
-                                 }),
-                  entities_.end());
+  if (entity == nullptr || entity->owner_ != this)
+    return;
+  removeEntity(entity->id_);
+}
+
+void EntityManager::removeEntity(core::EntityId id) {
+  Entity *entity = get(id);
+  if (entity == nullptr)
+    return;
+
+  unlink(*entity, entity->getPosition());
+  eraseAt(slots_[id.index].dense);
+}
+
+Entity *EntityManager::get(core::EntityId id) const noexcept {
+  if (id.index >= slots_.size())
+    return nullptr;
+  const Slot &slot = slots_[id.index];
+  if (slot.generation != id.generation)
+    return nullptr;
+  return entities_[slot.dense];
+}
+
+void EntityManager::eraseAt(std::uint32_t dense) {
+  Entity *entity = entities_[dense];
+  const std::uint32_t slot = entity->id_.index;
+  ++slots_[slot].generation; // invalidates outstanding ids
+  freeSlots_.push_back(slot);
+
+  if (dense + 1 != entities_.size()) {
+    entities_[dense] = entities_.back();
+    slots_[entities_[dense]->id_.index].dense = dense;
+  }
+  entities_.pop_back();
+  std::destroy_at(entity); // the cell is reused by the next add
+  ++revision_;
+}
+
+void EntityManager::clear() noexcept {
+  for (const Entity *entity : entities_) {
+    ++slots_[entity->id_.index].generation;
+    freeSlots_.push_back(entity->id_.index);
+  }
+  destroyAll();
+  entities_.clear();
+  std::fill(cells_.begin(), cells_.end(), nullptr);
+  outside_.clear();
+  ++revision_;
 }
 
 Entity *EntityManager::getEntityAt(const core::Position &pos) const {
-  for (const auto &entity : entities_) {
-    if (entity->getPosition() == pos) {
-      return entity.get();
+  if (pos.x < 0 || pos.y < 0) {
+    for (Entity *e : outside_) {
+      if (e->getPosition() == pos)
+        return e;
     }
+    return nullptr;
   }
-  return nullptr;
+  if (pos.x >= gridW_ || pos.y >= gridH_)
+    return nullptr;
+  return cells_[cellIndex(pos.x, pos.y)];
 }
 
 std::vector<Entity *>
 EntityManager::getEntitiesAt(const core::Position &pos) const {
   std::vector<Entity *> result;
-  for (const auto &entity : entities_) {
-    if (entity->getPosition() == pos) {
-      result.push_back(entity.get());
-    }
-  }
+  forEachInRect(pos, pos, [&](Entity &e) { result.push_back(&e); });
   return result;
 }
 
+std::vector<Entity *>
+EntityManager::getEntitiesInRect(const core::Position &min,
+                                 const core::Position &max) const {
+  std::vector<Entity *> result;
+  forEachInRect(min, max, [&](Entity &e) { result.push_back(&e); });
+  return result;
+}
+
+std::vector<Entity *>
+EntityManager::getEntitiesInRadius(const core::Position &center,
+                                   int radius) const {
+  // A Chebyshev circle is exactly its bounding square
+  return getEntitiesInRect({center.x - radius, center.y - radius},
+                           {center.x + radius, center.y + radius});
+}
+
+void EntityManager::onEntityMoved(Entity &entity, const core::Position &from) {
+  unlink(entity, from);
+  link(entity);
+  ++revision_;
+}
+
+void EntityManager::link(Entity &entity) {
+  const core::Position &pos = entity.getPosition();
+  entity.nextInCell_ = nullptr;
+
+  if (pos.x < 0 || pos.y < 0) {
+    outside_.push_back(&entity);
+    return;
+  }
+  if (pos.x >= gridW_ || pos.y >= gridH_) {
+    // Grow by at least half so entities walking off the edge stay amortized
+    rebuildIndex(std::max(pos.x + 1, gridW_ + gridW_ / 2),
+                 std::max(pos.y + 1, gridH_ + gridH_ / 2));
+    return;
+  }
+
+  // Append to keep insertion order (chains are a few entities at most)
+  Entity **slot = &cells_[cellIndex(pos.x, pos.y)];
+  while (*slot)
+    slot = &(*slot)->nextInCell_;
+  *slot = &entity;
+}
+
+void EntityManager::unlink(Entity &entity, const core::Position &pos) {
+  if (pos.x < 0 || pos.y < 0) {
+    outside_.erase(std::find(outside_.begin(), outside_.end(), &entity));
+  } else {
+    Entity **slot = &cells_[cellIndex(pos.x, pos.y)];
+    while (*slot != &entity)
+      slot = &(*slot)->nextInCell_;
+    *slot = entity.nextInCell_;
+  }
+  entity.nextInCell_ = nullptr;
+}
+
+void EntityManager::rebuildIndex(int width, int height) {
+  gridW_ = width;
+  gridH_ = height;
+  cells_.assign(static_cast<std::size_t>(gridW_) *
+                    static_cast<std::size_t>(gridH_),
+                nullptr);
+  outside_.clear();
+  for (Entity *entity : entities_)
+    link(*entity);
+}
+
 } // namespace entities
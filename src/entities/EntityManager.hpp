@@ -1,20 +1,62 @@
 #pragma once
 #include "Entity.hpp"
+#include "core/EntityId.hpp"
 #include "core/Position.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 namespace entities {
 
+// Owns entities and keeps a per-tile occupancy index of them.
+// Storage is a generational slot map: getEntities() is a dense array
+// (swap-and-pop on removal, so order is not preserved), and each entity
+// gets an EntityId whose slot maps to its dense position. Add, remove and
+// id lookup are O(1); ids of removed entities never resolve again.
+// Entities are constructed in place in a pool of fixed-size blocks, one
+// cell per slot: no allocation per entity, freed cells are reused, and an
+// Entity* stays valid (even across moves of the manager) until that
+// entity is removed. Long-lived references should hold the EntityId.
+// Each grid cell holds the head of an intrusive chain (Entity::nextInCell_)
+// of the entities standing there, in insertion order, so position queries
+// cost O(entities on the tile) instead of O(all entities).
+// Entities report their own moves through Entity::setPosition().
+// revision() bumps on add/remove/clear and on any change to an owned
+// entity (position, properties, glyph, AI), so savers can skip an
+// unchanged population.
 class EntityManager {
 public:
   EntityManager() = default;
 
-  // Add entity (takes ownership)
-  void addEntity(std::unique_ptr<Entity> entity);
+  // Pre-sizes the index for a width x height map; it still grows on demand
+  EntityManager(int width, int height);
 
-  // Remove entity by pointer
+  EntityManager(const EntityManager &) = delete;
+  EntityManager &operator=(const EntityManager &) = delete;
+  EntityManager(EntityManager &&other) noexcept;
+  EntityManager &operator=(EntityManager &&other) noexcept;
+  ~EntityManager();
+
+  // Construct an entity in the pool
+  Entity &createEntity(const std::string &name, const core::Position &pos);
+
+  // Move an unowned entity into the pool, returns its handle
+  // (the argument is left empty; use the handle from here on)
+  core::EntityId addEntity(Entity &&entity);
+
+  // Remove entity by pointer or handle (no-op if not owned / stale)
   void removeEntity(Entity *entity);
+  void removeEntity(core::EntityId id);
+
+  // Resolve handle, nullptr if the entity has been removed
+  Entity *get(core::EntityId id) const noexcept;
+  bool contains(core::EntityId id) const noexcept {
+    return get(id) != nullptr;
+  }
 
   // Get entity at position (returns first found, or nullptr)
   Entity *getEntityAt(const core::Position &pos) const;
@@ -22,19 +64,99 @@ public:
   // Get all entities at position
   std::vector<Entity *> getEntitiesAt(const core::Position &pos) const;
 
-  // Get all entities
-  const std::vector<std::unique_ptr<Entity>> &getEntities() const noexcept {
-    return entities_;
+  // Range queries (inclusive rectangle / Chebyshev radius, i.e. the same
+  // metric as 8-direction movement). Results are row-major.
+  std::vector<Entity *> getEntitiesInRect(const core::Position &min,
+                                          const core::Position &max) const;
+  std::vector<Entity *> getEntitiesInRadius(const core::Position &center,
+                                            int radius) const;
+
+  // Calls fn(Entity &) for each entity inside inclusive rectangle,
+  // without building a result vector
+  template <typename Fn>
+  void forEachInRect(const core::Position &min, const core::Position &max,
+                     Fn &&fn) const {
+    const int x0 = std::max(min.x, 0);
+    const int y0 = std::max(min.y, 0);
+    const int x1 = std::min(max.x, gridW_ - 1);
+    const int y1 = std::min(max.y, gridH_ - 1);
+    for (int y = y0; y <= y1; ++y) {
+      for (int x = x0; x <= x1; ++x) {
+        for (Entity *e = cells_[cellIndex(x, y)]; e; e = e->nextInCell_)
+          fn(*e);
+      }
+    }
+    for (Entity *e : outside_) {
+      const core::Position &p = e->getPosition();
+      if (p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y)
+        fn(*e);
+    }
   }
 
+  // Get all entities
+  std::span<Entity *const> getEntities() const noexcept { return entities_; }
+
   // Clear all entities
-  void clear() noexcept { entities_.clear(); }
+  void clear() noexcept;
 
   // Get entity count
   size_t count() const noexcept { return entities_.size(); }
 
+  std::uint64_t revision() const noexcept { return revision_; }
+
 private:
-  std::vector<std::unique_ptr<Entity>> entities_;
+  friend class Entity;
+
+  // Dense entity array (contiguous iteration), pointing into the pool
+  std::vector<Entity *> entities_;
+
+  // Pool: slot s lives in cell s % BLOCK_SIZE of blocks_[s / BLOCK_SIZE].
+  // Blocks are never moved or freed before the manager, only appended.
+  static constexpr std::size_t BLOCK_SIZE = 64;
+  struct Block {
+    alignas(Entity) std::byte cells[BLOCK_SIZE * sizeof(Entity)];
+  };
+  std::vector<std::unique_ptr<Block>> blocks_;
+
+  // Sparse slots: generation + dense position of the entity they hold
+  struct Slot {
+    std::uint32_t generation = 0;
+    std::uint32_t dense = 0;
+  };
+  std::vector<Slot> slots_;
+  std::vector<std::uint32_t> freeSlots_;
+
+  // Occupancy index: chain head per cell, row-major gridW_ x gridH_
+  int gridW_ = 0;
+  int gridH_ = 0;
+  std::vector<Entity *> cells_;
+  // Entities at negative coordinates - no grid cell, scanned linearly
+  std::vector<Entity *> outside_;
+  std::uint64_t revision_ = 0;
+
+  std::size_t cellIndex(int x, int y) const noexcept {
+    return static_cast<std::size_t>(y) * static_cast<std::size_t>(gridW_) +
+           static_cast<std::size_t>(x);
+  }
+
+  // Called by Entity::setPosition() for owned entities
+  void onEntityMoved(Entity &entity, const core::Position &from);
+
+  void link(Entity &entity);
+  void unlink(Entity &entity, const core::Position &pos);
+  // Reallocates the grid to at least width x height and relinks everyone
+  void rebuildIndex(int width, int height);
+  void adoptEntities() noexcept;
+  // Takes a free slot, adding a pool block when every cell is in use
+  std::uint32_t acquireSlot();
+  // Raw storage of a slot's pool cell
+  void *cell(std::uint32_t slot) const noexcept;
+  // Registers an entity just constructed in its slot's cell
+  void insert(Entity &entity, std::uint32_t slot);
+  // Destroys all entities (slots are released by the caller)
+  void destroyAll() noexcept;
+  // Releases slot of an entity at dense position i and swap-and-pops it
+  void eraseAt(std::uint32_t dense);
 };
 
 } // namespace entities
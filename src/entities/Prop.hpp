@@ -0,0 +1,39 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace entities {
+
+// Stats with a fixed slot in every Entity (hot-path lookups are array
+// indexes). Any other key goes through the string property API.
+enum class Prop : std::uint8_t {
+  HP,
+  MaxHP,
+  Str,
+  PhysRes, // percent
+  Speed,
+  Count
+};
+
+inline constexpr std::size_t PROP_COUNT = static_cast<std::size_t>(Prop::Count);
+
+// Canonical string keys (JSON, string property API)
+inline constexpr std::array<std::string_view, PROP_COUNT> PROP_NAMES = {
+    "hp", "max_hp", "str", "phys_res", "speed"};
+
+constexpr std::string_view propName(Prop prop) noexcept {
+  return PROP_NAMES[static_cast<std::size_t>(prop)];
+}
+
+constexpr std::optional<Prop> propFromName(std::string_view key) noexcept {
+  for (std::size_t i = 0; i < PROP_COUNT; ++i) {
+    if (PROP_NAMES[i] == key)
+      return static_cast<Prop>(i);
+  }
+  return std::nullopt;
+}
+
+} // namespace entities
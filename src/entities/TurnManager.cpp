@@ -1,73 +1,185 @@
 #include "TurnManager.hpp"
-#include <algorithm>
-#include <fstream>
+#include "core/Profiler.hpp"
+#include <utility>
 
 namespace entities {
 
-void TurnManager::addEntity(Entity *entity) {
-  int speed = entity->getProperty("speed", 100);
-  queue_.push({entity, 0}); // Start with 0 energy!
+void TurnManager::addEntity(const Entity &entity) {
+  const core::EntityId id = entity.getId();
+  if (!id.valid())
+    return;
+
+  if (id.index >= position_.size())
+    position_.resize(static_cast<std::size_t>(id.index) + 1, NOT_QUEUED);
+  const std::uint32_t queued = position_[id.index];
+  if (queued != NOT_QUEUED) {
+    if (heap_[queued].id == id)
+      return;
+    eraseAt(queued); // left behind by a removed entity that held the slot
+  }
+
+  TurnEntry entry{};
+  entry.id = id;
+  entry.speed = entity.get(Prop::Speed, 100);
+  entry.energy = 0; // Start with 0 energy!
+  entry.baseTick = now_;
+  entry.seq = nextSeq_++;
+  computeReady(entry);
+
+  heap_.push_back(entry);
+  siftUp(heap_.size() - 1);
 }
 
-void TurnManager::removeEntity(Entity *entity) {
-  std::priority_queue<TurnEntry> newQueue;
-  while (!queue_.empty()) {
-    TurnEntry entry = queue_.top();
-    queue_.pop();
-    if (entry.entity != entity) {
-      newQueue.push(entry);
-    }
-  }
-  queue_ = std::move(newQueue);
+void TurnManager::removeEntity(core::EntityId id) {
+  core::ProfileScope profile(core::ProfileBucket::Scheduling);
+
+  const std::size_t i = find(id);
+  if (i != heap_.size())
+    eraseAt(i);
 }
 
-Entity *TurnManager::getNextActor() {
-  if (queue_.empty())
-    return nullptr;
+void TurnManager::refreshSpeed(const Entity &entity) {
+  const std::size_t i = find(entity.getId());
+  if (i == heap_.size())
+    return;
+
+  TurnEntry &entry = heap_[i];
+  settle(entry); // energy gained so far used the old speed
+  entry.speed = entity.get(Prop::Speed, 100);
+  computeReady(entry);
+  fix(i);
+}
 
-  // Check if anyone can act (energy >= 100)
-  if (queue_.top().energy < 100) {
-    // No one ready - advance time for everyone
-    std::vector<TurnEntry> all;
-    while (!queue_.empty()) {
-      TurnEntry entry = queue_.top();
-      queue_.pop();
+core::EntityId TurnManager::getNextActor() {
+  core::ProfileScope profile(core::ProfileBucket::Scheduling);
 
-      int speed = entry.entity->getProperty("speed", 100);
-      entry.energy += speed;
+  if (heap_.empty())
+    return {};
 
-      all.push_back(entry);
-    }
+  advanceToTop();
+  return heap_.front().id;
+}
 
-    // Re-insert all
-    for (const auto &entry : all) {
-      queue_.push(entry);
-    }
+core::EntityId TurnManager::processTurn() {
+  core::ProfileScope profile(core::ProfileBucket::Scheduling);
+
+  if (heap_.empty())
+    return {};
+
+  advanceToTop();
+
+  // Subtract action cost and re-queue behind equally ready actors
+  TurnEntry &current = heap_.front();
+  settle(current);
+  current.energy -= ACTION_COST;
+  current.seq = nextSeq_++;
+  computeReady(current);
+  const core::EntityId actor = current.id;
+  siftDown(0);
+
+  return actor;
+}
+
+void TurnManager::clear() {
+  heap_.clear();
+  position_.clear();
+}
+
+std::size_t TurnManager::find(core::EntityId id) const noexcept {
+  if (id.index >= position_.size())
+    return heap_.size();
+  const std::uint32_t i = position_[id.index];
+  if (i == NOT_QUEUED || heap_[i].id != id)
+    return heap_.size();
+  return i;
+}
+
+void TurnManager::eraseAt(std::size_t i) {
+  position_[heap_[i].id.index] = NOT_QUEUED;
+  const std::size_t last = heap_.size() - 1;
+  if (i != last) {
+    place(i, heap_[last]);
+    heap_.pop_back();
+    fix(i);
+  } else {
+    heap_.pop_back();
   }
+}
 
-  return queue_.top().entity;
+void TurnManager::advanceToTop() {
+  const std::uint64_t ready = heap_.front().readyTick;
+  if (ready != NEVER && ready > now_)
+    now_ = ready;
 }
 
-Entity *TurnManager::processTurn() {
-  if (queue_.empty())
-    return nullptr;
+void TurnManager::settle(TurnEntry &entry) const {
+  entry.energy += static_cast<std::int64_t>(entry.speed) *
+                  static_cast<std::int64_t>(now_ - entry.baseTick);
+  entry.baseTick = now_;
+}
 
-  TurnEntry current = queue_.top();
-  queue_.pop();
+void TurnManager::computeReady(TurnEntry &entry) {
+  if (entry.energy >= READY_ENERGY) {
+    entry.readyTick = entry.baseTick;
+    entry.readyEnergy = entry.energy;
+  } else if (entry.speed <= 0) {
+    entry.readyTick = NEVER; // never gains energy
+    entry.readyEnergy = entry.energy;
+  } else {
+    const std::int64_t missing = READY_ENERGY - entry.energy;
+    const std::int64_t steps = (missing + entry.speed - 1) / entry.speed;
+    entry.readyTick = entry.baseTick + static_cast<std::uint64_t>(steps);
+    entry.readyEnergy = entry.energy + entry.speed * steps;
+  }
+}
 
-  // Subtract action cost
-  current.energy -= 100;
+bool TurnManager::before(const TurnEntry &a, const TurnEntry &b) noexcept {
+  if (a.readyTick != b.readyTick)
+    return a.readyTick < b.readyTick;
+  if (a.readyEnergy != b.readyEnergy)
+    return a.readyEnergy > b.readyEnergy; // higher energy acts first
+  return a.seq < b.seq;
+}
 
-  // Re-add to queue
-  queue_.push(current);
+void TurnManager::place(std::size_t i, TurnEntry entry) {
+  heap_[i] = entry;
+  position_[entry.id.index] = static_cast<std::uint32_t>(i);
+}
 
-  return current.entity;
+void TurnManager::siftUp(std::size_t i) {
+  TurnEntry entry = heap_[i];
+  while (i > 0) {
+    const std::size_t parent = (i - 1) / 2;
+    if (!before(entry, heap_[parent]))
+      break;
+    place(i, heap_[parent]);
+    i = parent;
+  }
+  place(i, entry);
 }
 
-void TurnManager::clear() {
-  while (!queue_.empty()) {
-    queue_.pop();
+void TurnManager::siftDown(std::size_t i) {
+  TurnEntry entry = heap_[i];
+  const std::size_t n = heap_.size();
+  while (true) {
+    std::size_t child = 2 * i + 1;
+    if (child >= n)
+      break;
+    if (child + 1 < n && before(heap_[child + 1], heap_[child]))
+      ++child;
+    if (!before(heap_[child], entry))
+      break;
+    place(i, heap_[child]);
+    i = child;
   }
+  place(i, entry);
+}
+
+void TurnManager::fix(std::size_t i) {
+  if (i > 0 && before(heap_[i], heap_[(i - 1) / 2]))
+    siftUp(i);
+  else
+    siftDown(i);
 }
 
 } // namespace entities
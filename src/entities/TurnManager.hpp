@@ -1,47 +1,98 @@
 #pragma once
 #include "Entity.hpp"
-#include <queue>
+#include "core/EntityId.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace entities {
 
-// Helper struct for priority queue
+// Scheduling state of one actor. Energy is stored as of baseTick and
+// extrapolated lazily (energy + speed * elapsed ticks), so advancing time
+// never touches the entries of actors that are not acting.
 struct TurnEntry {
-  Entity *entity;
-  int energy; // Higher = acts sooner
-
-  bool operator<(const TurnEntry &other) const {
-    return energy < other.energy; // Min-heap, so reverse for max behavior
-  }
+  core::EntityId id;
+  int speed;                // cached Prop::Speed (see refreshSpeed)
+  std::int64_t energy;      // energy at baseTick
+  std::uint64_t baseTick;   // tick the energy was last settled at
+  std::uint64_t readyTick;  // first tick with energy >= READY_ENERGY
+  std::int64_t readyEnergy; // energy at readyTick (higher acts first)
+  std::uint64_t seq;        // insertion / re-queue order (final tie-break)
 };
 
+// Energy-based turn order: every tick each actor gains speed energy and
+// acts once it has READY_ENERGY, paying ACTION_COST.
+// Implemented as an indexed binary heap keyed on (ready tick, energy at
+// that tick, sequence) with a global tick counter: time advances by
+// jumping to the top's ready tick, O(log n) per turn, add and remove.
+// Actors are scheduled by EntityId; heap positions live in an array
+// indexed by id slot, and callers resolve the returned ids through their
+// EntityManager, so the queue never holds an Entity* that could dangle.
 class TurnManager {
 public:
   TurnManager() = default;
 
-  // Add entity to turn queue (uses "speed" property, default 100)
-  void addEntity(Entity *entity);
+  static constexpr int READY_ENERGY = 100;
+  static constexpr int ACTION_COST = 100;
+
+  // Add entity to turn queue with 0 energy (caches "speed", default 100).
+  // The entity must be owned by an EntityManager (it is queued by id).
+  void addEntity(const Entity &entity);
 
-  // Remove entity from queue
-  void removeEntity(Entity *entity);
+  // Remove entity from queue by handle (no-op if not queued)
+  void removeEntity(core::EntityId id);
 
-  // Get next entity to act (returns nullptr if queue empty)
-  Entity *getNextActor();
+  // Re-reads the entity's speed (call after changing Prop::Speed)
+  void refreshSpeed(const Entity &entity);
+
+  // Get next entity to act (invalid id if queue empty).
+  // Advances time until someone is ready.
+  core::EntityId getNextActor();
 
   // Advance time - processes turn and returns acting entity
-  Entity *processTurn();
+  core::EntityId processTurn();
 
   // Check if queue is empty
-  bool isEmpty() const noexcept { return queue_.empty(); }
+  bool isEmpty() const noexcept { return heap_.empty(); }
+
+  bool contains(core::EntityId id) const noexcept {
+    return find(id) != heap_.size();
+  }
+
+  // Number of ticks elapsed
+  std::uint64_t currentTick() const noexcept { return now_; }
 
   // Clear all entities
   void clear();
 
 private:
-  std::priority_queue<TurnEntry> queue_;
+  static constexpr std::uint64_t NEVER =
+      std::numeric_limits<std::uint64_t>::max();
+  static constexpr std::uint32_t NOT_QUEUED =
+      std::numeric_limits<std::uint32_t>::max();
+
+  std::vector<TurnEntry> heap_;
+  std::vector<std::uint32_t> position_; // heap index per id slot
+  std::uint64_t now_ = 0;
+  std::uint64_t nextSeq_ = 0;
+
+  // Heap index of id, heap_.size() if not queued (or a stale generation)
+  std::size_t find(core::EntityId id) const noexcept;
+  void eraseAt(std::size_t i);
+
+  // Moves time forward to the top's ready tick if nobody is ready yet
+  void advanceToTop();
+
+  // Settles energy at now_ and recomputes readyTick / readyEnergy
+  void settle(TurnEntry &entry) const;
+  static void computeReady(TurnEntry &entry);
 
-  // Energy cost per turn (can be based on action type later)
-  static constexpr int TURN_COST = 10;
+  static bool before(const TurnEntry &a, const TurnEntry &b) noexcept;
+  void place(std::size_t i, TurnEntry entry);
+  void siftUp(std::size_t i);
+  void siftDown(std::size_t i);
+  void fix(std::size_t i);
 };
 
 } // namespace entities
@@ -1,7 +1,57 @@
 #include "Game.hpp"
+#include <charconv>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <string_view>
 
-int main() {
-  Game game;
+namespace {
+
+// Whole argument as a decimal in [lo, hi]; out is left alone otherwise
+template <typename T>
+bool parseValue(std::string_view text, T lo, T hi, T &out) {
+  T value{};
+  const char *end = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), end, value);
+  if (ec != std::errc{} || ptr != end || value < lo || value > hi)
+    return false;
+  out = value;
+  return true;
+}
+
+int usage() {
+  std::cerr << "usage: rl_demo [--seed N] [--autosave TURNS]\n";
+  return EXIT_FAILURE;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  // --seed N replays a dungeon; otherwise a fresh random one
+  std::uint64_t seed =
+      (static_cast<std::uint64_t>(std::random_device{}()) << 32) |
+      std::random_device{}();
+  int autosaveEvery = 0; // --autosave N: background save every N turns
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--seed" && i + 1 < argc) {
+      if (!parseValue(std::string_view(argv[++i]), std::uint64_t{0},
+                      ~std::uint64_t{0}, seed))
+        return usage();
+    } else if (arg == "--autosave" && i + 1 < argc) {
+      // 0 keeps autosave off; negative values are rejected
+      if (!parseValue(std::string_view(argv[++i]), 0,
+                      std::numeric_limits<int>::max(), autosaveEvery))
+        return usage();
+    } else {
+      return usage();
+    }
+  }
+
+  Game game(seed, autosaveEvery);
   game.run();
   return 0;
 }
@@ -2,6 +2,7 @@
 #include "core/FOV.hpp"
 #include "entities/Entity.hpp"
 #include "entities/EntityManager.hpp"
+#include "world/ExplorationMemory.hpp"
 #include "world/FeatureManager.hpp"
 #include "world/FeatureProperties.hpp"
 #include "world/Map.hpp"
@@ -54,52 +55,47 @@ Element FTXUIRenderer::buildGameView(const GameState &state) {
     return window(text("Game View"), text("Loading..."));
   }
 
-  std::vector<std::string> lines;
-
   int startX = state.cameraCenter.x - gameViewWidth_ / 2;
   int startY = state.cameraCenter.y - gameViewHeight_ / 2;
 
-  for (int y = 0; y < gameViewHeight_; ++y) {
-    std::string line;
-    for (int x = 0; x < gameViewWidth_; ++x) {
-      int worldX = startX + x;
-      int worldY = startY + y;
-
-      if (!state.map->inBounds({worldX, worldY}) ||
-          !state.fov->isVisible(worldX, worldY)) {
-        line += ' ';
-        continue;
-      }
-
-      // Cursor
-      if (state.cursor && state.cursor->x == worldX &&
-          state.cursor->y == worldY) {
-        line += 'X';
-        continue;
-      }
+  // Unseen cells stay blank - only visible cells in viewport are visited
+  std::vector<std::string> lines(
+      static_cast<size_t>(gameViewHeight_),
+      std::string(static_cast<size_t>(gameViewWidth_), ' '));
+
+  state.fov->forEachVisibleInRect(
+      startX, startY, startX + gameViewWidth_ - 1,
+      startY + gameViewHeight_ - 1, [&](int worldX, int worldY) {
+        char &cell = lines[static_cast<size_t>(worldY - startY)]
+                          [static_cast<size_t>(worldX - startX)];
+
+        // Cursor
+        if (state.cursor && state.cursor->x == worldX &&
+            state.cursor->y == worldY) {
+          cell = 'X';
+          return;
+        }
 
-      // Entity
-      entities::Entity *ent = state.entities->getEntityAt({worldX, worldY});
-      if (ent) {
-        line += ent->getGlyph();
-        continue;
-      }
+        // Entity
+        entities::Entity *ent = state.entities->getEntityAt({worldX, worldY});
+        if (ent) {
+          cell = ent->getGlyph();
+          return;
+        }
 
-      // Feature (doors, stairs)
-      if (state.features) {
-        const world::Feature *feature =
-            state.features->getFeature({worldX, worldY});
-        if (feature) {
-          line += world::getGlyph(*feature);
-          continue;
+        // Feature (doors, stairs)
+        if (state.features) {
+          const world::Feature *feature =
+              state.features->getFeature({worldX, worldY});
+          if (feature) {
+            cell = world::getGlyph(*feature);
+            return;
+          }
         }
-      }
 
-      // Tile (floor, wall)
-      line += tileToChar(state.map->at({worldX, worldY}));
-    }
-    lines.push_back(line);
-  }
+        // Tile (floor, wall)
+        cell = tileToChar(state.map->at({worldX, worldY}));
+      });
 
   // Convert to FTXUI elements
   std::vector<Element> lineElements;
@@ -242,14 +238,11 @@ Element FTXUIRenderer::buildMinimap(const GameState &state) {
         continue;
       }
 
-      // Check if any tile in region is discovered
-      bool discovered = false;
-      for (const auto &tile : state.discoveredTiles) {
-        if (tile.x / scaleX == x && tile.y / scaleY == y) {
-          discovered = true;
-          break;
-        }
-      }
+      // Check if any tile in region is discovered (word-masked bit test)
+      const bool discovered =
+          state.exploration &&
+          state.exploration->anyDiscoveredInRect(
+              worldX, worldY, worldX + scaleX - 1, worldY + scaleY - 1);
 
       line += discovered ? '.' : ' ';
     }
@@ -269,8 +262,8 @@ Element FTXUIRenderer::buildStatsBar(const GameState &state) {
     return text("Player: N/A");
   }
 
-  int currentHP = state.player->getProperty("hp");
-  int maxHP = state.player->getProperty("max_hp");
+  int currentHP = state.player->get(entities::Prop::HP);
+  int maxHP = state.player->get(entities::Prop::MaxHP);
   std::string hpBar = buildHPBar(currentHP, maxHP, 10);
 
   std::ostringstream oss;
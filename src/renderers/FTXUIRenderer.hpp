@@ -1,4 +1,5 @@
 #pragma once
+#include "core/FOV.hpp" // core::FOV is an alias, can't be forward-declared
 #include "core/Position.hpp"
 #include "world/Tile.hpp"
 #include <ftxui/dom/elements.hpp>
@@ -7,12 +8,10 @@
 #include <vector>
 
 // Forward declarations
-namespace core {
-class FOV;
-}
 namespace world {
 class Map;
 class FeatureManager;
+class ExplorationMemory;
 }
 namespace entities {
 class EntityManager;
@@ -40,7 +39,7 @@ struct GameState {
   int turn = 0;
 
   // Minimap
-  std::vector<core::Position> discoveredTiles;
+  const world::ExplorationMemory *exploration = nullptr;
 };
 
 class FTXUIRenderer {
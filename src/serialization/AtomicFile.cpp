@@ -0,0 +1,140 @@
+#include "AtomicFile.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace serialization {
+
+namespace {
+
+[[noreturn]] void fail(const std::string &what, const std::string &filename,
+                       int err) {
+  throw std::runtime_error(what + ": " + filename + " (" +
+                           std::strerror(err) + ")");
+}
+
+#ifndef _WIN32
+// Closes and deletes the temporary file, keeping the original errno
+[[noreturn]] void abandon(int fd, const std::string &tmp,
+                          const std::string &what) {
+  const int err = errno;
+  if (fd >= 0)
+    ::close(fd);
+  std::remove(tmp.c_str());
+  fail(what, tmp, err);
+}
+#endif
+
+} // namespace
+
+void appendToFile(const std::string &filename,
+                  std::span<const std::uint8_t> bytes, FsyncPolicy fsync) {
+#ifdef _WIN32
+  (void)fsync;
+  std::ofstream file(filename, std::ios::binary | std::ios::app);
+  if (!file.is_open())
+    fail("Failed to open file for writing", filename, errno);
+  file.write(reinterpret_cast<const char *>(bytes.data()),
+             static_cast<std::streamsize>(bytes.size()));
+  file.flush();
+  if (!file.good())
+    fail("Error writing to file", filename, errno);
+#else
+  const int fd = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  if (fd < 0)
+    fail("Failed to open file for writing", filename, errno);
+
+  auto closeAndFail = [fd, &filename](const std::string &what) {
+    const int err = errno;
+    ::close(fd);
+    fail(what, filename, err);
+  };
+  std::size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t n =
+        ::write(fd, bytes.data() + written, bytes.size() - written);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      closeAndFail("Error writing to file");
+    }
+    written += static_cast<std::size_t>(n);
+  }
+  if (fsync != FsyncPolicy::None && ::fsync(fd) != 0)
+    closeAndFail("Failed to sync file");
+  if (::close(fd) != 0)
+    fail("Error writing to file", filename, errno);
+#endif
+}
+
+void writeFileAtomic(const std::string &filename,
+                     std::span<const std::uint8_t> bytes, FsyncPolicy fsync) {
+  const std::string tmp = filename + ".tmp";
+
+#ifdef _WIN32
+  // No fsync here: flushing the stream is the best the standard offers
+  (void)fsync;
+  {
+    std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+    if (!file.is_open())
+      fail("Failed to open file for writing", tmp, errno);
+    file.write(reinterpret_cast<const char *>(bytes.data()),
+               static_cast<std::streamsize>(bytes.size()));
+    file.flush();
+    if (!file.good())
+      fail("Error writing to file", tmp, errno);
+  }
+  std::error_code ec;
+  std::filesystem::rename(tmp, filename, ec);
+  if (ec)
+    throw std::runtime_error("Failed to replace file: " + filename + " (" +
+                             ec.message() + ")");
+#else
+  const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    fail("Failed to open file for writing", tmp, errno);
+
+  std::size_t written = 0;
+  while (written < bytes.size()) {
+    const ssize_t n =
+        ::write(fd, bytes.data() + written, bytes.size() - written);
+    if (n < 0) {
+      if (errno == EINTR)
+        continue;
+      abandon(fd, tmp, "Error writing to file");
+    }
+    written += static_cast<std::size_t>(n);
+  }
+  if (fsync != FsyncPolicy::None && ::fsync(fd) != 0)
+    abandon(fd, tmp, "Failed to sync file");
+  if (::close(fd) != 0)
+    abandon(-1, tmp, "Error writing to file");
+  if (std::rename(tmp.c_str(), filename.c_str()) != 0)
+    abandon(-1, tmp, "Failed to replace file");
+
+  if (fsync == FsyncPolicy::FileAndDirectory) {
+    std::filesystem::path dir = std::filesystem::path(filename).parent_path();
+    if (dir.empty())
+      dir = ".";
+    const int dirFd = ::open(dir.c_str(), O_RDONLY | O_DIRECTORY);
+    if (dirFd < 0)
+      fail("Failed to open directory", dir.string(), errno);
+    const int rc = ::fsync(dirFd);
+    const int err = errno;
+    ::close(dirFd);
+    if (rc != 0)
+      fail("Failed to sync directory", dir.string(), err);
+  }
+#endif
+}
+
+} // namespace serialization
@@ -0,0 +1,30 @@
+#pragma once
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace serialization {
+
+// How hard writeFileAtomic() pushes data to disk before returning
+enum class FsyncPolicy {
+  None,            // leave it to the OS (fast, may lose the last save)
+  File,            // fsync the data before the rename
+  FileAndDirectory // also fsync the directory, so the rename is durable
+};
+
+// Writes bytes to filename + ".tmp" and renames it over filename, so
+// readers (and SaveArchive mappings) see the old file or the new one,
+// never a partial write. Throws std::runtime_error on failure, leaving
+// the old file in place.
+void writeFileAtomic(const std::string &filename,
+                     std::span<const std::uint8_t> bytes,
+                     FsyncPolicy fsync = FsyncPolicy::File);
+
+// Appends bytes to filename (created if missing). Not atomic: a crash can
+// leave a partial tail, so appended formats must detect torn records
+// (SaveJournal checksums each one). Throws std::runtime_error on failure.
+void appendToFile(const std::string &filename,
+                  std::span<const std::uint8_t> bytes,
+                  FsyncPolicy fsync = FsyncPolicy::File);
+
+} // namespace serialization
@@ -0,0 +1,88 @@
+#include "AutosaveService.hpp"
+#include "BinarySave.hpp"
+#include <chrono>
+#include <exception>
+#include <utility>
+
+namespace serialization {
+
+AutosaveService::AutosaveService(std::string filename, FsyncPolicy fsync,
+                                 std::size_t compactEvery)
+    : filename_(std::move(filename)), fsync_(fsync), tracker_(compactEvery) {}
+
+AutosaveService::~AutosaveService() { wait(); }
+
+bool AutosaveService::busy() {
+  if (!inFlight_.valid())
+    return false;
+  if (inFlight_.wait_for(std::chrono::seconds(0)) !=
+      std::future_status::ready)
+    return true;
+  collect();
+  return false;
+}
+
+bool AutosaveService::submit(SaveSnapshot snapshot) {
+  if (busy()) {
+    ++skipped_;
+    return false;
+  }
+  // The file no longer holds the tracker's base
+  tracker_.reset();
+  inFlight_ = worker_.submit(
+      [data = std::move(snapshot), filename = filename_, fsync = fsync_] {
+        const auto bytes = encodeBinary(data);
+        writeFileAtomic(filename, bytes, fsync);
+        return bytes.size();
+      });
+  return true;
+}
+
+bool AutosaveService::submitLevel(const world::Map &map,
+                                  const world::FeatureManager &features,
+                                  const entities::EntityManager &entities,
+                                  const core::BitGrid &discovered, int depth,
+                                  int turn) {
+  if (busy()) {
+    ++skipped_;
+    return false;
+  }
+  auto capture =
+      tracker_.capture(map, features, entities, discovered, depth, turn);
+  if (auto *snapshot = std::get_if<SaveSnapshot>(&capture)) {
+    ++compactions_;
+    inFlight_ = worker_.submit([data = std::move(*snapshot),
+                                filename = filename_, fsync = fsync_] {
+      return writeJournaledBase(filename, data, fsync);
+    });
+  } else {
+    ++journaled_;
+    inFlight_ = worker_.submit(
+        [record = std::move(std::get<JournalRecord>(capture)),
+         filename = filename_, fsync = fsync_] {
+          return appendJournalRecord(filename, record, fsync);
+        });
+  }
+  return true;
+}
+
+void AutosaveService::wait() {
+  if (inFlight_.valid()) {
+    inFlight_.wait();
+    collect();
+  }
+}
+
+void AutosaveService::collect() {
+  try {
+    bytesWritten_ += inFlight_.get();
+    ++saved_;
+  } catch (const std::exception &e) {
+    ++failed_;
+    lastError_ = e.what();
+    // The tracker is ahead of the file now: start over from a full save
+    tracker_.reset();
+  }
+}
+
+} // namespace serialization
@@ -0,0 +1,85 @@
+#pragma once
+#include "AtomicFile.hpp"
+#include "DeltaTracker.hpp"
+#include "SaveSnapshot.hpp"
+#include "core/ThreadPool.hpp"
+#include <cstdint>
+#include <future>
+#include <string>
+
+namespace serialization {
+
+// Background saves. The game thread takes a SaveSnapshot (a copy of tiles
+// and entity records) and hands it over; encoding and the atomic write run
+// on a single worker thread.
+//
+// Backpressure: at most one save is in flight. submit() while busy drops
+// the snapshot and counts it as skipped, so callers should test busy()
+// first and keep the autosave pending until it is accepted. Nothing here
+// ever blocks the game thread except wait() and the destructor.
+//
+// Journal mode (submitLevel): a DeltaTracker turns each save of the live
+// level into a small record appended to filename's journal, with a full
+// compaction every compactEvery saves (SaveJournal.hpp). loadGame() and
+// SaveArchive replay the journal on top of the base.
+//
+// Not thread-safe itself: call it from the game thread only.
+class AutosaveService {
+public:
+  explicit AutosaveService(
+      std::string filename, FsyncPolicy fsync = FsyncPolicy::File,
+      std::size_t compactEvery = DeltaTracker::DEFAULT_COMPACT_EVERY);
+  // Finishes the save in flight
+  ~AutosaveService();
+
+  AutosaveService(const AutosaveService &) = delete;
+  AutosaveService &operator=(const AutosaveService &) = delete;
+
+  bool busy();
+
+  // Starts writing snapshot; false (snapshot dropped) if a save is in flight
+  bool submit(SaveSnapshot snapshot);
+
+  // Journal mode: captures what changed in the level since the previous
+  // submitLevel() (or all of it when compacting); false if busy, before
+  // anything is captured. discovered may be empty (see DeltaTracker).
+  bool submitLevel(const world::Map &map, const world::FeatureManager &features,
+                   const entities::EntityManager &entities,
+                   const core::BitGrid &discovered, int depth, int turn);
+  // The live level was replaced: the next submitLevel() compacts
+  void levelChanged() noexcept { tracker_.reset(); }
+
+  // Blocks until the save in flight (if any) is done
+  void wait();
+
+  const std::string &filename() const noexcept { return filename_; }
+  std::uint64_t saved() const noexcept { return saved_; }
+  std::uint64_t skipped() const noexcept { return skipped_; }
+  std::uint64_t failed() const noexcept { return failed_; }
+  // Journal mode: how many saves were full compactions vs. records
+  std::uint64_t compactions() const noexcept { return compactions_; }
+  std::uint64_t journaled() const noexcept { return journaled_; }
+  // Bytes of every successful save
+  std::uint64_t bytesWritten() const noexcept { return bytesWritten_; }
+  // Message of the most recent failed save (empty if none failed)
+  const std::string &lastError() const noexcept { return lastError_; }
+
+private:
+  // Records the result of a finished save
+  void collect();
+
+  std::string filename_;
+  FsyncPolicy fsync_;
+  std::future<std::size_t> inFlight_; // bytes written
+  DeltaTracker tracker_;
+  std::uint64_t saved_ = 0;
+  std::uint64_t skipped_ = 0;
+  std::uint64_t failed_ = 0;
+  std::uint64_t compactions_ = 0;
+  std::uint64_t journaled_ = 0;
+  std::uint64_t bytesWritten_ = 0;
+  std::string lastError_;
+  core::ThreadPool worker_{1}; // declared last: joined first
+};
+
+} // namespace serialization
@@ -0,0 +1,309 @@
+#include "BinarySave.hpp"
+#include "ByteIO.hpp"
+#include "SaveSnapshot.hpp"
+#include "ai/AIBehavior.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+
+namespace serialization {
+
+namespace {
+
+constexpr std::uint8_t MAGIC[4] = {'R', 'L', 'S', 'V'};
+constexpr std::size_t HEADER_SIZE = 28;
+constexpr std::size_t LEVEL_ENTRY_SIZE = 12;
+
+// Interned strings for the whole file
+class StringTable {
+public:
+  std::uint64_t intern(const std::string &s) {
+    auto [it, inserted] = index_.try_emplace(s, strings_.size());
+    if (inserted)
+      strings_.push_back(s);
+    return it->second;
+  }
+
+  void write(ByteWriter &w) const {
+    w.varint(strings_.size());
+    for (const auto &s : strings_)
+      writeString(w, s);
+  }
+
+private:
+  std::unordered_map<std::string, std::uint64_t> index_;
+  std::vector<std::string> strings_;
+};
+
+std::vector<std::string> readStrings(ByteReader &r) {
+  std::vector<std::string> strings(r.count(r.remaining()));
+  for (auto &s : strings)
+    s = readString(r);
+  return strings;
+}
+
+void writeMap(ByteWriter &w, const LevelSnapshot &level) {
+  w.varint(static_cast<std::uint64_t>(level.width));
+  w.varint(static_cast<std::uint64_t>(level.height));
+  // Runs continue across row ends
+  world::Tile run = level.tiles.front();
+  std::uint64_t length = 0;
+  for (const world::Tile t : level.tiles) {
+    if (t != run) {
+      w.varint(length);
+      w.u8(static_cast<std::uint8_t>(run));
+      run = t;
+      length = 0;
+    }
+    ++length;
+  }
+  w.varint(length);
+  w.u8(static_cast<std::uint8_t>(run));
+}
+
+world::Map readMap(ByteReader &r) {
+  constexpr std::size_t MAX_SIDE = 1 << 15;
+  const int width = static_cast<int>(r.count(MAX_SIDE));
+  const int height = static_cast<int>(r.count(MAX_SIDE));
+  if (width == 0 || height == 0)
+    throw std::runtime_error("Binary save: empty map");
+
+  const std::size_t cells =
+      static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+  std::size_t done = 0;
+  std::size_t length = r.count(cells);
+  auto tile = [&r]() {
+    const std::uint8_t t = r.u8();
+    if (t >= world::TILE_COUNT)
+      throw std::runtime_error("Binary save: unknown tile");
+    return static_cast<world::Tile>(t);
+  };
+
+  // Runs expand into one buffer the Map adopts - no per-cell set(), so
+  // no layer updates or revision bumps while loading
+  std::vector<world::Tile> tiles;
+  tiles.reserve(cells);
+  while (true) {
+    tiles.insert(tiles.end(), length, tile());
+    done += length;
+    if (done == cells)
+      break;
+    length = r.count(cells - done);
+  }
+  return world::Map(width, height, std::move(tiles));
+}
+
+void writeDiscovered(ByteWriter &w, const std::vector<bool> &discovered) {
+  w.varint(discovered.size());
+  std::uint8_t byte = 0;
+  for (std::size_t i = 0; i < discovered.size(); ++i) {
+    if (discovered[i])
+      byte = static_cast<std::uint8_t>(byte | (1u << (i % 8)));
+    if (i % 8 == 7) {
+      w.u8(byte);
+      byte = 0;
+    }
+  }
+  if (discovered.size() % 8 != 0)
+    w.u8(byte);
+}
+
+std::vector<bool> readDiscovered(ByteReader &r) {
+  const std::size_t n = r.count(r.remaining() * 8);
+  auto packed = r.bytes((n + 7) / 8);
+  std::vector<bool> discovered(n);
+  for (std::size_t i = 0; i < n; ++i)
+    discovered[i] = (packed[i / 8] >> (i % 8)) & 1u;
+  return discovered;
+}
+
+void writeFeatures(ByteWriter &w, const LevelSnapshot &level) {
+  w.varint(level.features.size());
+  for (const auto &[pos, feature] : level.features) {
+    w.svarint(pos.x);
+    w.svarint(pos.y);
+    writeFeature(w, feature);
+  }
+}
+
+world::FeatureManager readFeatures(ByteReader &r) {
+  world::FeatureManager features;
+  const std::size_t n = r.count(r.remaining());
+  for (std::size_t i = 0; i < n; ++i) {
+    core::Position pos;
+    pos.x = r.intValue();
+    pos.y = r.intValue();
+    features.addFeature(pos, readFeatureBody(r, r.u8()));
+  }
+  return features;
+}
+
+void writeEntities(ByteWriter &w, StringTable &strings,
+                   const LevelSnapshot &level) {
+  w.varint(level.entities.size());
+  for (const EntitySnapshot &e : level.entities) {
+    w.varint(strings.intern(e.name));
+    w.svarint(e.position.x);
+    w.svarint(e.position.y);
+    w.u8(static_cast<std::uint8_t>(e.glyph));
+    w.varint(e.properties.size());
+    for (const auto &[key, value] : e.properties) {
+      w.varint(strings.intern(key));
+      w.svarint(value);
+    }
+    // 0 = no AI, otherwise string index + 1. Only SimpleAI exists (as in
+    // the JSON format)
+    w.varint(e.hasAI ? strings.intern("SimpleAI") + 1 : 0);
+  }
+}
+
+entities::EntityManager readEntities(ByteReader &r,
+                                     const std::vector<std::string> &strings) {
+  auto str = [&](std::uint64_t i) -> const std::string & {
+    if (i >= strings.size())
+      throw std::runtime_error("Binary save: bad string index");
+    return strings[static_cast<std::size_t>(i)];
+  };
+
+  entities::EntityManager em;
+  const std::size_t n = r.count(r.remaining());
+  for (std::size_t i = 0; i < n; ++i) {
+    const std::string &name = str(r.varint());
+    core::Position pos;
+    pos.x = r.intValue();
+    pos.y = r.intValue();
+    entities::Entity &entity = em.createEntity(name, pos);
+    entity.setGlyph(static_cast<char>(r.u8()));
+    const std::size_t props = r.count(r.remaining());
+    for (std::size_t p = 0; p < props; ++p) {
+      const std::string &key = str(r.varint());
+      entity.setProperty(key, r.intValue());
+    }
+    if (const std::uint64_t ai = r.varint(); ai != 0)
+      entity.setAI(createAIFromType(str(ai - 1)));
+  }
+  return em;
+}
+
+LevelState readLevel(std::span<const std::uint8_t> block, int depth,
+                     const std::vector<std::string> &strings) {
+  ByteReader r(block);
+  world::Map map = readMap(r);
+  std::vector<bool> discovered = readDiscovered(r);
+  world::FeatureManager features = readFeatures(r);
+  entities::EntityManager em = readEntities(r, strings);
+  return LevelState(std::move(map), std::move(features), std::move(em),
+                    std::move(discovered), depth);
+}
+
+} // namespace
+
+bool isBinarySave(std::span<const std::uint8_t> bytes) noexcept {
+  return bytes.size() >= sizeof(MAGIC) &&
+         std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) == 0;
+}
+
+std::vector<std::uint8_t> encodeBinary(const SaveData &data) {
+  return encodeBinary(snapshotSave(data));
+}
+
+std::vector<std::uint8_t> encodeBinary(const SaveSnapshot &data) {
+  // Levels first: their blocks fill the string table
+  StringTable strings;
+  std::vector<std::vector<std::uint8_t>> blocks;
+  blocks.reserve(data.levels.size());
+  for (const auto &level : data.levels) {
+    if (level.tiles.empty() ||
+        level.tiles.size() != static_cast<std::size_t>(level.width) *
+                                  static_cast<std::size_t>(level.height))
+      throw std::invalid_argument("Binary save: tiles do not match size");
+    auto &block = blocks.emplace_back();
+    ByteWriter w(block);
+    writeMap(w, level);
+    writeDiscovered(w, level.discovered);
+    writeFeatures(w, level);
+    writeEntities(w, strings, level);
+  }
+
+  std::vector<std::uint8_t> table;
+  ByteWriter tw(table);
+  strings.write(tw);
+
+  std::vector<std::uint8_t> out;
+  ByteWriter w(out);
+  w.bytes(MAGIC);
+  w.u16(BINARY_SAVE_VERSION);
+  w.u16(0);
+  w.i32(data.turn_counter);
+  w.i32(data.current_level_index);
+  w.u32(static_cast<std::uint32_t>(blocks.size()));
+  w.u64(data.save_id);
+
+  std::size_t offset =
+      HEADER_SIZE + LEVEL_ENTRY_SIZE * blocks.size() + table.size();
+  for (std::size_t i = 0; i < blocks.size(); ++i) {
+    w.u32(static_cast<std::uint32_t>(offset));
+    w.u32(static_cast<std::uint32_t>(blocks[i].size()));
+    w.i32(data.levels[i].depth);
+    offset += blocks[i].size();
+  }
+  w.bytes(table);
+  for (const auto &block : blocks)
+    w.bytes(block);
+  return out;
+}
+
+BinaryIndex readBinaryIndex(std::span<const std::uint8_t> bytes) {
+  if (!isBinarySave(bytes))
+    throw std::runtime_error("Binary save: bad magic");
+  ByteReader r(bytes);
+  r.bytes(sizeof(MAGIC));
+  const std::uint16_t version = r.u16();
+  if (version == 0 || version > BINARY_SAVE_VERSION)
+    throw std::runtime_error("Binary save: unsupported version " +
+                             std::to_string(version));
+  r.u16(); // reserved
+
+  BinaryIndex index;
+  index.turn_counter = r.i32();
+  index.current_level_index = r.i32();
+  const std::uint32_t levels = r.u32();
+  if (version >= 2)
+    index.save_id = r.u64();
+  if (levels > r.remaining() / LEVEL_ENTRY_SIZE)
+    throw std::runtime_error("Binary save: truncated data");
+
+  index.levels.resize(levels);
+  for (auto &e : index.levels) {
+    e.offset = r.u32();
+    e.size = r.u32();
+    e.depth = r.i32();
+    if (e.offset > bytes.size() || e.size > bytes.size() - e.offset)
+      throw std::runtime_error("Binary save: level out of range");
+  }
+  index.strings = readStrings(r);
+  return index;
+}
+
+LevelState decodeBinaryLevel(std::span<const std::uint8_t> bytes,
+                             const BinaryIndex &index, std::size_t level) {
+  const BinaryLevelEntry &e = index.levels.at(level);
+  return readLevel(bytes.subspan(e.offset, e.size), e.depth, index.strings);
+}
+
+SaveData decodeBinary(std::span<const std::uint8_t> bytes) {
+  const BinaryIndex index = readBinaryIndex(bytes);
+  SaveData data;
+  data.turn_counter = index.turn_counter;
+  data.current_level_index = index.current_level_index;
+  data.visited_levels.reserve(index.levels.size());
+  for (std::size_t i = 0; i < index.levels.size(); ++i)
+    data.visited_levels.push_back(decodeBinaryLevel(bytes, index, i));
+  return data;
+}
+
+} // namespace serialization
@@ -0,0 +1,63 @@
+#pragma once
+#include "Gameserialization.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace serialization {
+
+struct SaveSnapshot;
+
+// Compact binary SaveData encoding (the default save format; JSON stays
+// as a debug export). All integers are little-endian.
+//
+//   Header       "RLSV", u16 version, u16 reserved,
+//                i32 turn_counter, i32 current_level_index, u32 level_count,
+//                u64 save_id (version 2+)
+//   Level table  level_count x { u32 offset, u32 size, i32 depth }
+//   String table varint count, then { varint length, bytes } - entity
+//                names, property keys and AI types, referenced by index
+//   Level blocks map (varint width/height, tile runs as {varint length,
+//                u8 tile}), discovered mask (bitpacked, row-major),
+//                features, entities
+//
+// Signed values inside blocks are zigzag varints. Offsets are from the
+// start of the file, so one level can be decoded without the others.
+// save_id ties a save journal (SaveJournal.hpp) to the base it extends;
+// 0 means no journal. Version 1 files (no save_id) still load.
+constexpr std::uint16_t BINARY_SAVE_VERSION = 2;
+
+// True if bytes start with the binary save magic
+bool isBinarySave(std::span<const std::uint8_t> bytes) noexcept;
+
+std::vector<std::uint8_t> encodeBinary(const SaveData &data);
+// Same bytes from a detached snapshot (safe to run off the game thread)
+std::vector<std::uint8_t> encodeBinary(const SaveSnapshot &data);
+
+// Throws std::runtime_error on bad magic, unknown version or corrupt data
+SaveData decodeBinary(std::span<const std::uint8_t> bytes);
+
+// Piecewise decoding (SaveArchive): the index is the header, level table
+// and string table; levels are then decoded one at a time.
+struct BinaryLevelEntry {
+  std::uint32_t offset = 0;
+  std::uint32_t size = 0;
+  std::int32_t depth = 0;
+};
+
+struct BinaryIndex {
+  int turn_counter = 0;
+  int current_level_index = 0;
+  std::uint64_t save_id = 0;
+  std::vector<BinaryLevelEntry> levels;
+  std::vector<std::string> strings;
+};
+
+BinaryIndex readBinaryIndex(std::span<const std::uint8_t> bytes);
+
+// Reads only the bytes of that level's block
+LevelState decodeBinaryLevel(std::span<const std::uint8_t> bytes,
+                             const BinaryIndex &index, std::size_t level);
+
+} // namespace serialization
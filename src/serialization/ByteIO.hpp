@@ -0,0 +1,187 @@
+#pragma once
+#include "world/Feature.hpp"
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace serialization {
+
+// Little-endian fixed-width and LEB128 varint primitives shared by the
+// binary save (BinarySave) and the save journal (SaveJournal). Readers
+// bounds-check everything and throw std::runtime_error on bad input.
+
+class ByteWriter {
+public:
+  explicit ByteWriter(std::vector<std::uint8_t> &out) : out_(out) {}
+
+  void u8(std::uint8_t v) { out_.push_back(v); }
+  void u16(std::uint16_t v) { fixed(v, 2); }
+  void u32(std::uint32_t v) { fixed(v, 4); }
+  void i32(std::int32_t v) { u32(static_cast<std::uint32_t>(v)); }
+  void u64(std::uint64_t v) {
+    u32(static_cast<std::uint32_t>(v));
+    u32(static_cast<std::uint32_t>(v >> 32));
+  }
+
+  void varint(std::uint64_t v) {
+    while (v >= 0x80) {
+      out_.push_back(static_cast<std::uint8_t>(v | 0x80));
+      v >>= 7;
+    }
+    out_.push_back(static_cast<std::uint8_t>(v));
+  }
+  void svarint(std::int64_t v) {
+    varint((static_cast<std::uint64_t>(v) << 1) ^
+           static_cast<std::uint64_t>(v >> 63));
+  }
+
+  void bytes(std::span<const std::uint8_t> b) {
+    out_.insert(out_.end(), b.begin(), b.end());
+  }
+
+private:
+  void fixed(std::uint32_t v, int n) {
+    for (int i = 0; i < n; ++i)
+      out_.push_back(static_cast<std::uint8_t>(v >> (8 * i)));
+  }
+
+  std::vector<std::uint8_t> &out_;
+};
+
+class ByteReader {
+public:
+  explicit ByteReader(std::span<const std::uint8_t> in) : in_(in) {}
+
+  std::uint8_t u8() {
+    need(1);
+    return in_[pos_++];
+  }
+  std::uint16_t u16() { return static_cast<std::uint16_t>(fixed(2)); }
+  std::uint32_t u32() { return fixed(4); }
+  std::int32_t i32() { return static_cast<std::int32_t>(u32()); }
+  std::uint64_t u64() {
+    const std::uint64_t low = u32();
+    return low | static_cast<std::uint64_t>(u32()) << 32;
+  }
+
+  std::uint64_t varint() {
+    std::uint64_t v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const std::uint8_t b = u8();
+      v |= static_cast<std::uint64_t>(b & 0x7F) << shift;
+      if (!(b & 0x80))
+        return v;
+    }
+    throw std::runtime_error("Save data: varint too long");
+  }
+  std::int64_t svarint() {
+    const std::uint64_t v = varint();
+    return static_cast<std::int64_t>(v >> 1) ^
+           -static_cast<std::int64_t>(v & 1);
+  }
+  int intValue() {
+    const std::int64_t v = svarint();
+    if (v < std::numeric_limits<int>::min() ||
+        v > std::numeric_limits<int>::max())
+      throw std::runtime_error("Save data: value out of range");
+    return static_cast<int>(v);
+  }
+  std::size_t count(std::size_t limit) {
+    const std::uint64_t v = varint();
+    if (v > limit)
+      throw std::runtime_error("Save data: count out of range");
+    return static_cast<std::size_t>(v);
+  }
+
+  std::span<const std::uint8_t> bytes(std::size_t n) {
+    need(n);
+    auto s = in_.subspan(pos_, n);
+    pos_ += n;
+    return s;
+  }
+
+  std::size_t remaining() const noexcept { return in_.size() - pos_; }
+
+private:
+  void need(std::size_t n) const {
+    if (n > in_.size() - pos_)
+      throw std::runtime_error("Save data: truncated data");
+  }
+  std::uint32_t fixed(int n) {
+    need(static_cast<std::size_t>(n));
+    std::uint32_t v = 0;
+    for (int i = 0; i < n; ++i)
+      v |= static_cast<std::uint32_t>(in_[pos_++]) << (8 * i);
+    return v;
+  }
+
+  std::span<const std::uint8_t> in_;
+  std::size_t pos_ = 0;
+};
+
+inline void writeString(ByteWriter &w, const std::string &s) {
+  w.varint(s.size());
+  w.bytes({reinterpret_cast<const std::uint8_t *>(s.data()), s.size()});
+}
+
+inline std::string readString(ByteReader &r) {
+  auto b = r.bytes(r.count(r.remaining()));
+  return std::string(reinterpret_cast<const char *>(b.data()), b.size());
+}
+
+// Feature: u8 type, then Door {u8 material, u8 state} or
+// Stairs {u8 direction, zigzag target_depth}
+inline constexpr std::uint8_t FEATURE_DOOR = 0;
+inline constexpr std::uint8_t FEATURE_STAIRS = 1;
+
+inline void writeFeature(ByteWriter &w, const world::Feature &feature) {
+  std::visit(
+      [&w](const auto &f) {
+        using T = std::decay_t<decltype(f)>;
+        if constexpr (std::is_same_v<T, world::Door>) {
+          w.u8(FEATURE_DOOR);
+          w.u8(static_cast<std::uint8_t>(f.material));
+          w.u8(static_cast<std::uint8_t>(f.state));
+        } else if constexpr (std::is_same_v<T, world::Stairs>) {
+          w.u8(FEATURE_STAIRS);
+          w.u8(static_cast<std::uint8_t>(f.direction));
+          w.svarint(f.target_depth);
+        }
+      },
+      feature);
+}
+
+// One enum byte of a feature, rejected past the enum's last value
+template <typename Enum> Enum readFeatureField(ByteReader &r, Enum last) {
+  const std::uint8_t v = r.u8();
+  if (v > static_cast<std::uint8_t>(last))
+    throw std::runtime_error("Save data: unknown feature field");
+  return static_cast<Enum>(v);
+}
+
+// type was already read by the caller (the journal uses extra values)
+inline world::Feature readFeatureBody(ByteReader &r, std::uint8_t type) {
+  switch (type) {
+  case FEATURE_DOOR: {
+    world::Door door;
+    door.material = readFeatureField(r, world::Door::Material::Stone);
+    door.state = readFeatureField(r, world::Door::State::Closed);
+    return door;
+  }
+  case FEATURE_STAIRS: {
+    world::Stairs stairs;
+    stairs.direction = readFeatureField(r, world::Stairs::Direction::Up);
+    stairs.target_depth = r.intValue();
+    return stairs;
+  }
+  default:
+    throw std::runtime_error("Save data: unknown feature type");
+  }
+}
+
+} // namespace serialization
@@ -0,0 +1,241 @@
+#include "DeltaTracker.hpp"
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+namespace serialization {
+
+namespace {
+
+std::uint64_t packId(core::EntityId id) noexcept {
+  return static_cast<std::uint64_t>(id.index) << 32 | id.generation;
+}
+
+bool sameFeature(const world::Feature &a, const world::Feature &b) noexcept {
+  if (a.index() != b.index())
+    return false;
+  if (const auto *door = std::get_if<world::Door>(&a)) {
+    const auto &other = std::get<world::Door>(b);
+    return door->material == other.material && door->state == other.state;
+  }
+  const auto &stairs = std::get<world::Stairs>(a);
+  const auto &other = std::get<world::Stairs>(b);
+  return stairs.direction == other.direction &&
+         stairs.target_depth == other.target_depth;
+}
+
+std::uint64_t randomSaveId() {
+  std::random_device rd;
+  return static_cast<std::uint64_t>(rd()) << 32 | rd();
+}
+
+} // namespace
+
+DeltaTracker::DeltaTracker(std::size_t compactEvery)
+    : compactEvery_(compactEvery == 0 ? 1 : compactEvery),
+      nextSaveId_(randomSaveId()) {}
+
+DeltaTracker::Capture
+DeltaTracker::capture(const world::Map &map,
+                      const world::FeatureManager &features,
+                      const entities::EntityManager &entities,
+                      const core::BitGrid &discovered, int depth, int turn) {
+  if (discovered.width() != 0 && (discovered.width() != map.width() ||
+                                  discovered.height() != map.height()))
+    throw std::invalid_argument("DeltaTracker: discovered grid size mismatch");
+  if (needsCompaction(map, features, entities, discovered, depth))
+    return compact(map, features, entities, discovered, depth, turn);
+
+  // A forgotten cell cannot be journaled (records only add discoveries)
+  if (forgotCells(discovered))
+    return compact(map, features, entities, discovered, depth, turn);
+
+  JournalRecord record;
+  record.turn_counter = turn;
+  record.depth = depth;
+  diffDiscovered(discovered, record);
+  diffTiles(map, record);
+  diffFeatures(features, record);
+  diffEntities(entities, record);
+  ++records_;
+  return record;
+}
+
+bool DeltaTracker::needsCompaction(const world::Map &map,
+                                   const world::FeatureManager &features,
+                                   const entities::EntityManager &entities,
+                                   const core::BitGrid &discovered,
+                                   int depth) const {
+  return !hasBase_ || records_ >= compactEvery_ || depth != depth_ ||
+         &map != map_ || &features != features_ || &entities != entities_ ||
+         map.tiles().size() != tiles_.size() ||
+         discovered.width() != discovered_.width() ||
+         discovered.height() != discovered_.height();
+}
+
+bool DeltaTracker::forgotCells(const core::BitGrid &discovered) const {
+  for (int y = 0; y < discovered.height(); ++y) {
+    const auto cur = discovered.row(y);
+    const auto old = discovered_.row(y);
+    for (std::size_t w = 0; w < cur.size(); ++w) {
+      if (old[w] & ~cur[w])
+        return true;
+    }
+  }
+  return false;
+}
+
+SaveSnapshot DeltaTracker::compact(const world::Map &map,
+                                   const world::FeatureManager &features,
+                                   const entities::EntityManager &entities,
+                                   const core::BitGrid &discovered, int depth,
+                                   int turn) {
+  std::vector<bool> cells(map.tiles().size());
+  discovered.forEachSet([&](int x, int y) {
+    cells[static_cast<std::size_t>(y) * static_cast<std::size_t>(map.width()) +
+          static_cast<std::size_t>(x)] = true;
+  });
+
+  SaveSnapshot snapshot;
+  snapshot.turn_counter = turn;
+  if (nextSaveId_ == 0)
+    ++nextSaveId_; // 0 means "no journal"
+  snapshot.save_id = nextSaveId_++;
+  const LevelSnapshot &level = snapshot.levels.emplace_back(
+      snapshotLevel(map, features, entities, std::move(cells), depth));
+
+  hasBase_ = true;
+  saveId_ = snapshot.save_id;
+  records_ = 0;
+  depth_ = depth;
+  map_ = &map;
+  features_ = &features;
+  entities_ = &entities;
+
+  tileRevision_ = map.tileRevision();
+  featureRevision_ = features.revision();
+  entityRevision_ = entities.revision();
+  tiles_ = level.tiles;
+  discovered_ = discovered;
+  savedFeatures_.clear();
+  for (const auto &[pos, feature] : level.features)
+    savedFeatures_.emplace(pos, feature);
+
+  // Keys follow the order the base stores (and reloads) entities in
+  savedEntities_.clear();
+  nextKey_ = 0;
+  for (const auto &e : entities.getEntities()) {
+    if (!e)
+      continue;
+    savedEntities_[packId(e->getId())] =
+        TrackedEntity{nextKey_, level.entities[nextKey_]};
+    ++nextKey_;
+  }
+  return snapshot;
+}
+
+void DeltaTracker::diffTiles(const world::Map &map, JournalRecord &record) {
+  if (map.tileRevision() == tileRevision_)
+    return;
+  tileRevision_ = map.tileRevision();
+  const auto tiles = map.tiles();
+  for (std::size_t i = 0; i < tiles.size(); ++i) {
+    if (tiles[i] != tiles_[i]) {
+      tiles_[i] = tiles[i];
+      record.tiles.emplace_back(static_cast<std::uint32_t>(i), tiles[i]);
+    }
+  }
+}
+
+void DeltaTracker::diffDiscovered(const core::BitGrid &discovered,
+                                  JournalRecord &record) {
+  const auto width = static_cast<std::uint32_t>(discovered.width());
+  for (int y = 0; y < discovered.height(); ++y) {
+    const auto cur = discovered.row(y);
+    const auto old = discovered_.row(y);
+    for (std::size_t w = 0; w < cur.size(); ++w) {
+      core::BitGrid::Word added = cur[w] & ~old[w];
+      if (added == 0)
+        continue;
+      old[w] = cur[w];
+      for (; added != 0; added &= added - 1) {
+        const auto x = static_cast<std::uint32_t>(
+            w * core::BitGrid::WORD_BITS +
+            static_cast<std::size_t>(std::countr_zero(added)));
+        record.discovered.push_back(static_cast<std::uint32_t>(y) * width +
+                                    x);
+      }
+    }
+  }
+}
+
+void DeltaTracker::diffFeatures(const world::FeatureManager &features,
+                                JournalRecord &record) {
+  if (features.revision() == featureRevision_)
+    return;
+  featureRevision_ = features.revision();
+
+  for (const core::Position &pos : features.getAllPositions()) {
+    const world::Feature &feature = *features.getFeature(pos);
+    auto it = savedFeatures_.find(pos);
+    if (it == savedFeatures_.end()) {
+      savedFeatures_.emplace(pos, feature);
+    } else if (!sameFeature(it->second, feature)) {
+      it->second = feature;
+    } else {
+      continue;
+    }
+    record.features.emplace_back(pos, feature);
+  }
+  for (auto it = savedFeatures_.begin(); it != savedFeatures_.end();) {
+    if (features.hasFeature(it->first)) {
+      ++it;
+      continue;
+    }
+    record.features.emplace_back(it->first, std::nullopt);
+    it = savedFeatures_.erase(it);
+  }
+  // Hash order is not stable across runs
+  std::sort(record.features.begin(), record.features.end(),
+            [](const auto &a, const auto &b) {
+              return std::tie(a.first.y, a.first.x) <
+                     std::tie(b.first.y, b.first.x);
+            });
+}
+
+void DeltaTracker::diffEntities(const entities::EntityManager &entities,
+                                JournalRecord &record) {
+  if (entities.revision() == entityRevision_)
+    return;
+  entityRevision_ = entities.revision();
+
+  std::unordered_map<std::uint64_t, TrackedEntity> alive;
+  alive.reserve(entities.count());
+  for (const auto &e : entities.getEntities()) {
+    if (!e)
+      continue;
+    const std::uint64_t id = packId(e->getId());
+    EntitySnapshot snap = snapshotEntity(*e);
+    auto it = savedEntities_.find(id);
+    if (it == savedEntities_.end()) {
+      record.entities.emplace_back(nextKey_, snap);
+      alive.emplace(id, TrackedEntity{nextKey_++, std::move(snap)});
+      continue;
+    }
+    if (!(it->second.snapshot == snap)) {
+      record.entities.emplace_back(it->second.key, snap);
+      it->second.snapshot = std::move(snap);
+    }
+    alive.emplace(id, std::move(it->second));
+    savedEntities_.erase(it);
+  }
+  // Whatever was not seen has been removed
+  for (const auto &[id, tracked] : savedEntities_)
+    record.removedEntities.push_back(tracked.key);
+  std::sort(record.removedEntities.begin(), record.removedEntities.end());
+  savedEntities_ = std::move(alive);
+}
+
+} // namespace serialization
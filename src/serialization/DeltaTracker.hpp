@@ -0,0 +1,89 @@
+#pragma once
+#include "SaveJournal.hpp"
+#include "core/BitGrid.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace serialization {
+
+// Turns successive captures of one live level into journal records.
+// It keeps a copy of what was last saved and uses the revision counters
+// of Map (tileRevision), FeatureManager and EntityManager to skip every
+// part that did not change, so a capture costs the discovered-bits diff
+// (one word compare per 64 cells) plus whatever actually changed.
+//
+// capture() returns a full SaveSnapshot with a new save_id (compaction)
+// when there is no base yet, the level changed identity (other objects,
+// depth or size), discovered cells were forgotten, reset() was called or
+// compactEvery records have been journaled; otherwise a JournalRecord
+// (possibly empty). Callers must write every capture, in order - after a
+// failed write call reset() so the next capture compacts.
+class DeltaTracker {
+public:
+  static constexpr std::size_t DEFAULT_COMPACT_EVERY = 64;
+
+  using Capture = std::variant<SaveSnapshot, JournalRecord>;
+
+  explicit DeltaTracker(std::size_t compactEvery = DEFAULT_COMPACT_EVERY);
+
+  // discovered is map-sized, or empty when the level has no exploration
+  // memory
+  Capture capture(const world::Map &map, const world::FeatureManager &features,
+                  const entities::EntityManager &entities,
+                  const core::BitGrid &discovered, int depth, int turn);
+
+  // Next capture compacts (new level, failed write)
+  void reset() noexcept { hasBase_ = false; }
+
+  std::uint64_t saveId() const noexcept { return saveId_; }
+  std::size_t recordsSinceBase() const noexcept { return records_; }
+
+private:
+  struct TrackedEntity {
+    std::uint32_t key = 0;
+    EntitySnapshot snapshot;
+  };
+
+  SaveSnapshot compact(const world::Map &map,
+                       const world::FeatureManager &features,
+                       const entities::EntityManager &entities,
+                       const core::BitGrid &discovered, int depth, int turn);
+  bool needsCompaction(const world::Map &map,
+                       const world::FeatureManager &features,
+                       const entities::EntityManager &entities,
+                       const core::BitGrid &discovered, int depth) const;
+  bool forgotCells(const core::BitGrid &discovered) const;
+  void diffTiles(const world::Map &map, JournalRecord &record);
+  void diffDiscovered(const core::BitGrid &discovered, JournalRecord &record);
+  void diffFeatures(const world::FeatureManager &features,
+                    JournalRecord &record);
+  void diffEntities(const entities::EntityManager &entities,
+                    JournalRecord &record);
+
+  std::size_t compactEvery_;
+  std::uint64_t nextSaveId_;
+
+  bool hasBase_ = false;
+  std::uint64_t saveId_ = 0;
+  std::size_t records_ = 0;
+  int depth_ = 0;
+  const world::Map *map_ = nullptr;
+  const world::FeatureManager *features_ = nullptr;
+  const entities::EntityManager *entities_ = nullptr;
+
+  // State as of the last capture
+  std::uint64_t tileRevision_ = 0;
+  std::uint64_t featureRevision_ = 0;
+  std::uint64_t entityRevision_ = 0;
+  std::vector<world::Tile> tiles_;
+  core::BitGrid discovered_;
+  std::unordered_map<core::Position, world::Feature, core::PositionHash>
+      savedFeatures_;
+  std::unordered_map<std::uint64_t, TrackedEntity> savedEntities_; // by id
+  std::uint32_t nextKey_ = 0;
+};
+
+} // namespace serialization
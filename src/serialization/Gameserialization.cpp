@@ -1,43 +1,49 @@
-#include "serialization/GameSerialization.hpp"
+#include "serialization/Gameserialization.hpp"
+#include "AtomicFile.hpp"
+#include "BinarySave.hpp"
+#include "JsonSaveReader.hpp"
+#include "SaveJournal.hpp"
 #include <fstream>
+#include <iterator>
 #include <stdexcept>
 
 using json = nlohmann::json;
 
 namespace serialization {
 
-void saveGame(const SaveData &data, const std::string &filename) {
-  json j;
-  to_json(j, data); // Explicit call
-
-  std::ofstream file(filename);
-  if (!file.is_open()) {
-    throw std::runtime_error("Failed to open file for writing: " + filename);
-  }
-
-  file << j.dump(2); // Pretty print with 2-space indent
-
-  if (!file.good()) {
-    throw std::runtime_error("Error writing to file: " + filename);
+void saveGame(const SaveData &data, const std::string &filename,
+              SaveFormat format) {
+  // Replaced by rename: an interrupted save keeps the previous file
+  if (format == SaveFormat::Binary) {
+    writeFileAtomic(filename, encodeBinary(data));
+  } else {
+    json j;
+    to_json(j, data);                   // Explicit call
+    const std::string text = j.dump(2); // Pretty print with 2-space indent
+    writeFileAtomic(filename,
+                    {reinterpret_cast<const std::uint8_t *>(text.data()),
+                     text.size()});
   }
 }
 
 SaveData loadGame(const std::string &filename) {
-  std::ifstream file(filename);
+  std::ifstream file(filename, std::ios::binary);
   if (!file.is_open()) {
     throw std::runtime_error("Failed to open file for reading: " + filename);
   }
 
-  json j;
-  try {
-    file >> j;
-  } catch (const json::exception &e) {
-    throw std::runtime_error("JSON parse error: " + std::string(e.what()));
+  const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(file),
+                                        std::istreambuf_iterator<char>()};
+  if (isBinarySave(bytes)) {
+    SaveData data = decodeBinary(bytes);
+    if (const auto saveId = readBinaryIndex(bytes).save_id; saveId != 0) {
+      applyJournal(data, readJournalFile(filename, saveId));
+    }
+    return data;
   }
 
-  SaveData data;
-  from_json(j, data); // Explicit call
-  return data;
+  // Streamed: no json DOM next to the SaveData being built
+  return readJsonSave(bytes);
 }
 
 } // namespace serialization
@@ -122,8 +128,8 @@ void from_json(const json &j, EntityManager &em) {
   em.clear();
 
   for (const auto &entity_json : j) {
-    auto entity = std::make_unique<Entity>("", core::Position{0, 0});
-    entity_json.get_to(*entity);
+    Entity entity("", core::Position{0, 0});
+    entity_json.get_to(entity);
     em.addEntity(std::move(entity));
   }
 }
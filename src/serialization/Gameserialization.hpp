@@ -10,6 +10,10 @@
 namespace serialization {
 
 // State of a single level (for level stacking)
+// features is always attached to map, so the map's feature layers (closed
+// doors blocking sight and movement) are live on every loaded level. The
+// constructor binds them and moves re-bind, since the FeatureManager
+// binding does not follow a moved Map.
 struct LevelState {
   world::Map map;
   world::FeatureManager features;
@@ -21,7 +25,29 @@ struct LevelState {
   LevelState(world::Map m, world::FeatureManager f, entities::EntityManager e,
              std::vector<bool> d, int dep)
       : map(std::move(m)), features(std::move(f)), entities(std::move(e)),
-        discovered(std::move(d)), depth(dep) {}
+        discovered(std::move(d)), depth(dep) {
+    attachFeatures();
+  }
+
+  LevelState(LevelState &&other) noexcept
+      : map(std::move(other.map)), features(std::move(other.features)),
+        entities(std::move(other.entities)),
+        discovered(std::move(other.discovered)), depth(other.depth) {
+    attachFeatures();
+  }
+  LevelState &operator=(LevelState &&other) noexcept {
+    map = std::move(other.map);
+    features = std::move(other.features);
+    entities = std::move(other.entities);
+    discovered = std::move(other.discovered);
+    depth = other.depth;
+    attachFeatures();
+    return *this;
+  }
+
+  // Binds features to map and rebuilds its feature layers, O(features).
+  // Needed again only after moving map or features out separately.
+  void attachFeatures() { features.attach(&map); }
 };
 
 // Complete save game data
@@ -33,10 +59,16 @@ struct SaveData {
   SaveData() : current_level_index(0), turn_counter(0) {}
 };
 
+// On-disk format. Binary is the normal save (see BinarySave.hpp); Json is
+// a human-readable debug export.
+enum class SaveFormat { Binary, Json };
+
 // Save game to file
-void saveGame(const SaveData &data, const std::string &filename);
+void saveGame(const SaveData &data, const std::string &filename,
+              SaveFormat format = SaveFormat::Binary);
 
-// Load game from file (throws on error)
+// Load game from file, detecting the format (throws on error). A binary
+// save's journal (SaveJournal.hpp) is replayed on top of it.
 SaveData loadGame(const std::string &filename);
 
 } // namespace serialization
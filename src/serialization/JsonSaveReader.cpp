@@ -0,0 +1,481 @@
+#include "JsonSaveReader.hpp"
+#include "ai/AIBehavior.hpp"
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace serialization {
+
+namespace {
+
+using json = nlohmann::json;
+
+constexpr std::size_t MAX_CELLS = std::size_t{1} << 30;
+
+[[noreturn]] void fail(const std::string &what) {
+  throw std::runtime_error("JSON save: " + what);
+}
+
+template <typename T> T require(const std::optional<T> &value,
+                                const char *field) {
+  if (!value)
+    fail(std::string("missing ") + field);
+  return *value;
+}
+
+int toInt(std::int64_t v) {
+  if (v < std::numeric_limits<int>::min() ||
+      v > std::numeric_limits<int>::max())
+    fail("value out of range");
+  return static_cast<int>(v);
+}
+
+// Feature enum field, rejected outside [0, last]
+template <typename Enum>
+Enum featureField(const std::optional<int> &value, const char *field,
+                  Enum last) {
+  const int v = require(value, field);
+  if (v < 0 || v > static_cast<int>(last))
+    fail(std::string("unknown ") + field);
+  return static_cast<Enum>(v);
+}
+
+// SAX handler with an explicit context stack. Scalars are routed by the
+// enclosing context and the last key; anything unrecognised is skipped.
+class SaveHandler final : public nlohmann::json_sax<json> {
+public:
+  SaveData take() {
+    if (!rootDone_)
+      fail("expected an object");
+    require(turnCounter_, "turn_counter");
+    require(currentLevel_, "current_level_index");
+    if (!hasLevels_)
+      fail("missing visited_levels");
+    data_.turn_counter = *turnCounter_;
+    data_.current_level_index = *currentLevel_;
+    return std::move(data_);
+  }
+
+  bool null() override {
+    scalarOnly("null");
+    return true;
+  }
+  bool boolean(bool value) override {
+    if (top() == Ctx::Discovered)
+      level_->discovered.push_back(value);
+    else
+      scalarOnly("boolean");
+    return true;
+  }
+  bool number_integer(number_integer_t value) override {
+    integer(value);
+    return true;
+  }
+  bool number_unsigned(number_unsigned_t value) override {
+    if (value > static_cast<number_unsigned_t>(
+                    std::numeric_limits<std::int64_t>::max()))
+      fail("value out of range");
+    integer(static_cast<std::int64_t>(value));
+    return true;
+  }
+  bool number_float(number_float_t value, const string_t &) override {
+    // As json::get<int>() would: truncated
+    if (!(value >= -9.2e18 && value <= 9.2e18))
+      fail("value out of range");
+    integer(static_cast<std::int64_t>(value));
+    return true;
+  }
+  bool string(string_t &value) override;
+  bool binary(binary_t &) override { return true; }
+
+  bool start_object(std::size_t) override;
+  bool end_object() override;
+  bool start_array(std::size_t) override;
+  bool end_array() override;
+  bool key(string_t &value) override {
+    key_ = value;
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string &,
+                   const nlohmann::detail::exception &ex) override {
+    throw std::runtime_error("JSON parse error: " + std::string(ex.what()));
+  }
+
+private:
+  enum class Ctx {
+    Root,
+    Levels,
+    Level,
+    Map,
+    Tiles,
+    Discovered,
+    Features,
+    FeatureItem,
+    FeatureBody,
+    Entities,
+    Entity,
+    Position,
+    Properties,
+    Skip
+  };
+
+  struct PendingLevel {
+    std::optional<int> depth;
+    std::optional<int> width;
+    std::optional<int> height;
+    bool hasMap = false;
+    bool hasTiles = false;
+    bool hasFeatures = false;
+    bool hasEntities = false;
+    bool hasDiscovered = false;
+    std::vector<world::Tile> tiles;
+    std::vector<bool> discovered;
+    world::FeatureManager features;
+    // Held until the level closes: "entities" sorts before "map", and the
+    // manager's occupancy index is sized from width and height
+    std::vector<entities::Entity> entities;
+  };
+
+  struct PendingPosition {
+    std::optional<int> x;
+    std::optional<int> y;
+  };
+
+  struct PendingFeature {
+    std::optional<core::Position> position;
+    bool hasBody = false;
+    std::optional<std::string> type;
+    std::optional<int> material;
+    std::optional<int> state;
+    std::optional<int> direction;
+    std::optional<int> targetDepth;
+  };
+
+  struct PendingEntity {
+    std::optional<std::string> name;
+    std::optional<core::Position> position;
+    std::optional<std::string> glyph;
+    bool hasProperties = false;
+    std::vector<std::pair<std::string, int>> properties;
+    std::optional<std::string> aiType;
+  };
+
+  Ctx top() const {
+    if (stack_.empty())
+      fail("expected an object");
+    return stack_.back();
+  }
+
+  // Tiles and discovered cells must be plain values of their type
+  void scalarOnly(const char *type) const {
+    if (top() == Ctx::Tiles || top() == Ctx::Discovered)
+      fail(std::string("unexpected ") + type + " in " +
+           (top() == Ctx::Tiles ? "tiles" : "discovered"));
+  }
+
+  void integer(std::int64_t value);
+  world::Feature makeFeature() const;
+  void finishLevel();
+  void finishFeature();
+  void finishEntity();
+
+  std::vector<Ctx> stack_;
+  std::string key_;
+  SaveData data_;
+  std::optional<int> turnCounter_;
+  std::optional<int> currentLevel_;
+  bool hasLevels_ = false;
+  bool rootDone_ = false;
+
+  std::optional<PendingLevel> level_;
+  PendingFeature feature_;
+  PendingEntity entity_;
+  PendingPosition position_;
+  std::optional<core::Position> *positionOut_ = nullptr;
+};
+
+void SaveHandler::integer(std::int64_t value) {
+  switch (top()) {
+  case Ctx::Root:
+    if (key_ == "turn_counter")
+      turnCounter_ = toInt(value);
+    else if (key_ == "current_level_index")
+      currentLevel_ = toInt(value);
+    break;
+  case Ctx::Level:
+    if (key_ == "depth")
+      level_->depth = toInt(value);
+    break;
+  case Ctx::Map:
+    if (key_ == "width")
+      level_->width = toInt(value);
+    else if (key_ == "height")
+      level_->height = toInt(value);
+    break;
+  case Ctx::Tiles:
+    if (value < 0 || static_cast<std::uint64_t>(value) >= world::TILE_COUNT)
+      fail("unknown tile " + std::to_string(value));
+    level_->tiles.push_back(static_cast<world::Tile>(value));
+    break;
+  case Ctx::Discovered:
+    fail("unexpected number in discovered");
+  case Ctx::FeatureBody:
+    if (key_ == "material")
+      feature_.material = toInt(value);
+    else if (key_ == "state")
+      feature_.state = toInt(value);
+    else if (key_ == "direction")
+      feature_.direction = toInt(value);
+    else if (key_ == "target_depth")
+      feature_.targetDepth = toInt(value);
+    break;
+  case Ctx::Position:
+    if (key_ == "x")
+      position_.x = toInt(value);
+    else if (key_ == "y")
+      position_.y = toInt(value);
+    break;
+  case Ctx::Properties:
+    entity_.properties.emplace_back(key_, toInt(value));
+    break;
+  default:
+    break;
+  }
+}
+
+bool SaveHandler::string(string_t &value) {
+  switch (top()) {
+  case Ctx::FeatureBody:
+    if (key_ == "type")
+      feature_.type = std::move(value);
+    break;
+  case Ctx::Entity:
+    if (key_ == "name")
+      entity_.name = std::move(value);
+    else if (key_ == "glyph")
+      entity_.glyph = std::move(value);
+    else if (key_ == "ai_type")
+      entity_.aiType = std::move(value);
+    break;
+  default:
+    scalarOnly("string");
+    break;
+  }
+  return true;
+}
+
+bool SaveHandler::start_object(std::size_t) {
+  if (stack_.empty()) {
+    if (rootDone_)
+      fail("expected an object");
+    stack_.push_back(Ctx::Root);
+    return true;
+  }
+
+  Ctx next = Ctx::Skip;
+  switch (top()) {
+  case Ctx::Levels:
+    level_.emplace();
+    next = Ctx::Level;
+    break;
+  case Ctx::Level:
+    if (key_ == "map") {
+      level_->hasMap = true;
+      next = Ctx::Map;
+    }
+    break;
+  case Ctx::Features:
+    feature_ = {};
+    next = Ctx::FeatureItem;
+    break;
+  case Ctx::FeatureItem:
+    if (key_ == "position") {
+      positionOut_ = &feature_.position;
+      next = Ctx::Position;
+    } else if (key_ == "feature") {
+      feature_.hasBody = true;
+      next = Ctx::FeatureBody;
+    }
+    break;
+  case Ctx::Entities:
+    entity_ = {};
+    next = Ctx::Entity;
+    break;
+  case Ctx::Entity:
+    if (key_ == "position") {
+      positionOut_ = &entity_.position;
+      next = Ctx::Position;
+    } else if (key_ == "properties") {
+      entity_.hasProperties = true;
+      next = Ctx::Properties;
+    }
+    break;
+  default:
+    scalarOnly("object");
+    break;
+  }
+  if (next == Ctx::Position)
+    position_ = {};
+  stack_.push_back(next);
+  return true;
+}
+
+bool SaveHandler::end_object() {
+  const Ctx ctx = top();
+  stack_.pop_back();
+  switch (ctx) {
+  case Ctx::Root:
+    rootDone_ = true;
+    break;
+  case Ctx::Level:
+    finishLevel();
+    break;
+  case Ctx::FeatureItem:
+    finishFeature();
+    break;
+  case Ctx::Entity:
+    finishEntity();
+    break;
+  case Ctx::Position:
+    *positionOut_ = core::Position{require(position_.x, "x"),
+                                   require(position_.y, "y")};
+    break;
+  default:
+    break;
+  }
+  return true;
+}
+
+bool SaveHandler::start_array(std::size_t) {
+  Ctx next = Ctx::Skip;
+  switch (top()) {
+  case Ctx::Root:
+    if (key_ == "visited_levels") {
+      hasLevels_ = true;
+      next = Ctx::Levels;
+    }
+    break;
+  case Ctx::Level:
+    if (key_ == "features") {
+      level_->hasFeatures = true;
+      next = Ctx::Features;
+    } else if (key_ == "entities") {
+      level_->hasEntities = true;
+      next = Ctx::Entities;
+    } else if (key_ == "discovered") {
+      level_->hasDiscovered = true;
+      next = Ctx::Discovered;
+    }
+    break;
+  case Ctx::Map:
+    if (key_ == "tiles") {
+      level_->hasTiles = true;
+      // The discovered mask is parallel to the map, and with sorted keys
+      // it arrives before width and height do
+      std::size_t expected = level_->discovered.size();
+      if (level_->width && level_->height && *level_->width > 0 &&
+          *level_->height > 0)
+        expected = static_cast<std::size_t>(*level_->width) *
+                   static_cast<std::size_t>(*level_->height);
+      level_->tiles.reserve(std::min(expected, MAX_CELLS));
+      next = Ctx::Tiles;
+    }
+    break;
+  default:
+    scalarOnly("array");
+    break;
+  }
+  stack_.push_back(next);
+  return true;
+}
+
+bool SaveHandler::end_array() {
+  stack_.pop_back();
+  return true;
+}
+
+world::Feature SaveHandler::makeFeature() const {
+  const std::string &type = require(feature_.type, "type");
+  if (type == "Door") {
+    world::Door door;
+    door.material = featureField(feature_.material, "material",
+                                 world::Door::Material::Stone);
+    door.state =
+        featureField(feature_.state, "state", world::Door::State::Closed);
+    return door;
+  }
+  if (type == "Stairs") {
+    world::Stairs stairs;
+    stairs.direction = featureField(feature_.direction, "direction",
+                                    world::Stairs::Direction::Up);
+    stairs.target_depth = require(feature_.targetDepth, "target_depth");
+    return stairs;
+  }
+  fail("unknown feature type " + type);
+}
+
+void SaveHandler::finishFeature() {
+  const core::Position pos = require(feature_.position, "position");
+  if (!feature_.hasBody)
+    fail("missing feature");
+  level_->features.addFeature(pos, makeFeature());
+}
+
+void SaveHandler::finishEntity() {
+  const std::string &glyph = require(entity_.glyph, "glyph");
+  if (!entity_.hasProperties)
+    fail("missing properties");
+  entities::Entity &entity = level_->entities.emplace_back(
+      require(entity_.name, "name"), require(entity_.position, "position"));
+  entity.setGlyph(glyph.empty() ? '\0' : glyph[0]);
+  for (const auto &[key, value] : entity_.properties)
+    entity.setProperty(key, value);
+  if (entity_.aiType)
+    entity.setAI(createAIFromType(*entity_.aiType));
+}
+
+void SaveHandler::finishLevel() {
+  PendingLevel &level = *level_;
+  const int depth = require(level.depth, "depth");
+  if (!level.hasMap)
+    fail("missing map");
+  const int width = require(level.width, "width");
+  const int height = require(level.height, "height");
+  if (!level.hasTiles)
+    fail("missing tiles");
+  if (!level.hasFeatures)
+    fail("missing features");
+  if (!level.hasEntities)
+    fail("missing entities");
+  if (!level.hasDiscovered)
+    fail("missing discovered");
+  if (width <= 0 || height <= 0 ||
+      level.tiles.size() != static_cast<std::size_t>(width) *
+                                static_cast<std::size_t>(height))
+    fail("tiles do not match map size");
+
+  entities::EntityManager entities(width, height);
+  for (auto &entity : level.entities)
+    entities.addEntity(std::move(entity));
+  data_.visited_levels.emplace_back(
+      world::Map(width, height, std::move(level.tiles)),
+      std::move(level.features), std::move(entities),
+      std::move(level.discovered), depth);
+  level_.reset();
+}
+
+} // namespace
+
+SaveData readJsonSave(std::span<const std::uint8_t> bytes) {
+  SaveHandler handler;
+  json::sax_parse(bytes.begin(), bytes.end(), &handler);
+  return handler.take();
+}
+
+} // namespace serialization
@@ -0,0 +1,19 @@
+#pragma once
+#include "Gameserialization.hpp"
+#include <cstdint>
+#include <span>
+
+namespace serialization {
+
+// Streaming loader for JSON saves (the debug export and legacy saves).
+// Runs nlohmann's SAX parser and builds the SaveData straight from the
+// tokens: tiles go into one buffer the Map adopts, features into their
+// manager as each object closes, entities into an EntityManager sized
+// from the map once the level closes. No json DOM is built, so peak
+// memory is the SaveData plus one level's tile buffer.
+//
+// Unknown keys are skipped. Throws std::runtime_error on malformed JSON
+// ("JSON parse error: ...") and on missing or invalid fields.
+SaveData readJsonSave(std::span<const std::uint8_t> bytes);
+
+} // namespace serialization
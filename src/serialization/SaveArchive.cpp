@@ -0,0 +1,123 @@
+#include "SaveArchive.hpp"
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace serialization {
+
+SaveArchive::SaveArchive(const std::string &filename) {
+#ifdef _WIN32
+  // No mmap: read the whole file, levels are still decoded lazily
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open file for reading: " + filename);
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(file),
+                 std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+#else
+  const int fd = ::open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open file for reading: " + filename);
+  }
+  struct stat st {};
+  if (::fstat(fd, &st) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Failed to stat file: " + filename);
+  }
+  size_ = static_cast<std::size_t>(st.st_size);
+  if (size_ > 0) {
+    void *mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Failed to map file: " + filename);
+    }
+    data_ = static_cast<const std::uint8_t *>(mapped);
+    // Levels are read in random order
+    ::madvise(mapped, size_, MADV_RANDOM);
+  }
+  ::close(fd); // the mapping stays valid
+#endif
+
+  try {
+    if (!isBinarySave(bytes()))
+      throw std::runtime_error("Not a binary save: " + filename);
+    index_ = readBinaryIndex(bytes());
+    if (index_.save_id != 0)
+      journal_ = readJournalFile(filename, index_.save_id);
+  } catch (...) {
+    unmap();
+    throw;
+  }
+}
+
+SaveArchive::~SaveArchive() { unmap(); }
+
+SaveArchive::SaveArchive(SaveArchive &&other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)), buffer_(std::move(other.buffer_)),
+      index_(std::move(other.index_)), journal_(std::move(other.journal_)) {}
+
+SaveArchive &SaveArchive::operator=(SaveArchive &&other) noexcept {
+  if (this != &other) {
+    unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    buffer_ = std::move(other.buffer_);
+    index_ = std::move(other.index_);
+    journal_ = std::move(other.journal_);
+  }
+  return *this;
+}
+
+void SaveArchive::unmap() noexcept {
+#ifndef _WIN32
+  if (data_)
+    ::munmap(const_cast<std::uint8_t *>(data_), size_);
+#endif
+  data_ = nullptr;
+  size_ = 0;
+  buffer_.clear();
+}
+
+std::optional<std::size_t> SaveArchive::findDepth(int depth) const noexcept {
+  for (std::size_t i = 0; i < index_.levels.size(); ++i)
+    if (index_.levels[i].depth == depth)
+      return i;
+  return std::nullopt;
+}
+
+int SaveArchive::turnCounter() const noexcept {
+  return journal_.empty() ? index_.turn_counter
+                          : journal_.back().turn_counter;
+}
+
+LevelState SaveArchive::loadLevel(std::size_t level) const {
+  LevelState state = decodeBinaryLevel(bytes(), index_, level);
+  applyJournal(state, journal_);
+  return state;
+}
+
+LevelState SaveArchive::loadCurrentLevel() const {
+  if (index_.current_level_index < 0)
+    throw std::out_of_range("SaveArchive: no current level");
+  return loadLevel(static_cast<std::size_t>(index_.current_level_index));
+}
+
+SaveData SaveArchive::loadAll() const {
+  SaveData data = decodeBinary(bytes());
+  applyJournal(data, journal_);
+  return data;
+}
+
+} // namespace serialization
@@ -0,0 +1,63 @@
+#pragma once
+#include "BinarySave.hpp"
+#include "SaveJournal.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace serialization {
+
+// Read-only view of a binary save file with per-level lazy decoding.
+// Opening maps the file and reads only the header, level table and string
+// table; loadLevel() decodes one level's block, so only its pages are
+// touched. Startup cost and resident memory do not grow with the number
+// of visited levels.
+//
+// Saves are replaced by rename (never rewritten in place), so a mapped
+// archive keeps seeing the file it opened. A matching journal is read
+// (into memory, it is small) at open and replayed by every load.
+class SaveArchive {
+public:
+  // Throws std::runtime_error if the file cannot be opened or is not a
+  // binary save (JSON debug exports go through loadGame)
+  explicit SaveArchive(const std::string &filename);
+  ~SaveArchive();
+
+  SaveArchive(const SaveArchive &) = delete;
+  SaveArchive &operator=(const SaveArchive &) = delete;
+  SaveArchive(SaveArchive &&other) noexcept;
+  SaveArchive &operator=(SaveArchive &&other) noexcept;
+
+  int turnCounter() const noexcept;
+  int currentLevelIndex() const noexcept { return index_.current_level_index; }
+  std::size_t levelCount() const noexcept { return index_.levels.size(); }
+
+  // From the level table, nothing is decoded
+  int levelDepth(std::size_t level) const {
+    return index_.levels.at(level).depth;
+  }
+  std::optional<std::size_t> findDepth(int depth) const noexcept;
+
+  LevelState loadLevel(std::size_t level) const;
+  LevelState loadCurrentLevel() const;
+
+  // Everything, as loadGame() would return it
+  SaveData loadAll() const;
+
+private:
+  std::span<const std::uint8_t> bytes() const noexcept {
+    return {data_, size_};
+  }
+  void unmap() noexcept;
+
+  const std::uint8_t *data_ = nullptr;
+  std::size_t size_ = 0;
+  std::vector<std::uint8_t> buffer_; // read into memory where mmap is missing
+  BinaryIndex index_;
+  std::vector<JournalRecord> journal_;
+};
+
+} // namespace serialization
@@ -0,0 +1,314 @@
+#include "SaveJournal.hpp"
+#include "BinarySave.hpp"
+#include "ByteIO.hpp"
+#include "ai/AIBehavior.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace serialization {
+
+namespace {
+
+constexpr std::uint8_t MAGIC[4] = {'R', 'L', 'J', 'N'};
+constexpr std::size_t HEADER_SIZE = 16;
+constexpr std::size_t FRAME_SIZE = 8; // payload size + checksum
+constexpr std::uint8_t FEATURE_REMOVED = 0xFF;
+constexpr std::size_t MAX_KEY = std::numeric_limits<std::uint32_t>::max();
+
+std::uint32_t fnv1a(std::span<const std::uint8_t> bytes) noexcept {
+  std::uint32_t hash = 2166136261u;
+  for (const std::uint8_t b : bytes) {
+    hash ^= b;
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+// Cells are written as zigzag deltas from the previous one, so the
+// usual ascending runs cost a byte or two each
+void writeCell(ByteWriter &w, std::uint32_t cell, std::uint32_t &prev) {
+  w.svarint(static_cast<std::int64_t>(cell) - static_cast<std::int64_t>(prev));
+  prev = cell;
+}
+
+std::uint32_t readCell(ByteReader &r, std::uint32_t &prev) {
+  const std::int64_t cell = static_cast<std::int64_t>(prev) + r.svarint();
+  if (cell < 0 || cell > std::numeric_limits<std::uint32_t>::max())
+    throw std::runtime_error("Save journal: cell out of range");
+  prev = static_cast<std::uint32_t>(cell);
+  return prev;
+}
+
+void writeEntity(ByteWriter &w, const EntitySnapshot &e) {
+  writeString(w, e.name);
+  w.svarint(e.position.x);
+  w.svarint(e.position.y);
+  w.u8(static_cast<std::uint8_t>(e.glyph));
+  w.varint(e.properties.size());
+  for (const auto &[key, value] : e.properties) {
+    writeString(w, key);
+    w.svarint(value);
+  }
+  w.u8(e.hasAI ? 1 : 0);
+}
+
+EntitySnapshot readEntity(ByteReader &r) {
+  EntitySnapshot e;
+  e.name = readString(r);
+  e.position.x = r.intValue();
+  e.position.y = r.intValue();
+  e.glyph = static_cast<char>(r.u8());
+  e.properties.resize(r.count(r.remaining()));
+  for (auto &[key, value] : e.properties) {
+    key = readString(r);
+    value = r.intValue();
+  }
+  e.hasAI = r.u8() != 0;
+  return e;
+}
+
+JournalRecord readRecord(std::span<const std::uint8_t> payload) {
+  ByteReader r(payload);
+  JournalRecord record;
+  record.turn_counter = r.intValue();
+  record.depth = r.intValue();
+
+  std::uint32_t prev = 0;
+  record.tiles.resize(r.count(r.remaining()));
+  for (auto &[cell, tile] : record.tiles) {
+    cell = readCell(r, prev);
+    const std::uint8_t t = r.u8();
+    if (t >= world::TILE_COUNT)
+      throw std::runtime_error("Save journal: unknown tile");
+    tile = static_cast<world::Tile>(t);
+  }
+
+  prev = 0;
+  record.discovered.resize(r.count(r.remaining()));
+  for (auto &cell : record.discovered)
+    cell = readCell(r, prev);
+
+  record.features.resize(r.count(r.remaining()));
+  for (auto &[pos, feature] : record.features) {
+    pos.x = r.intValue();
+    pos.y = r.intValue();
+    if (const std::uint8_t type = r.u8(); type != FEATURE_REMOVED)
+      feature = readFeatureBody(r, type);
+  }
+
+  record.removedEntities.resize(r.count(r.remaining()));
+  for (auto &key : record.removedEntities)
+    key = static_cast<std::uint32_t>(r.count(MAX_KEY));
+
+  record.entities.resize(r.count(r.remaining()));
+  for (auto &[key, entity] : record.entities) {
+    key = static_cast<std::uint32_t>(r.count(MAX_KEY));
+    entity = readEntity(r);
+  }
+  if (r.remaining() != 0)
+    throw std::runtime_error("Save journal: trailing bytes in record");
+  return record;
+}
+
+entities::Entity makeEntity(const EntitySnapshot &snap) {
+  entities::Entity entity(snap.name, snap.position);
+  entity.setGlyph(snap.glyph);
+  for (const auto &[key, value] : snap.properties)
+    entity.setProperty(key, value);
+  if (snap.hasAI)
+    entity.setAI(createAIFromType("SimpleAI"));
+  return entity;
+}
+
+} // namespace
+
+std::string journalFilename(const std::string &filename) {
+  return filename + ".journal";
+}
+
+std::vector<std::uint8_t> encodeJournalHeader(std::uint64_t saveId) {
+  std::vector<std::uint8_t> out;
+  out.reserve(HEADER_SIZE);
+  ByteWriter w(out);
+  w.bytes(MAGIC);
+  w.u16(SAVE_JOURNAL_VERSION);
+  w.u16(0);
+  w.u64(saveId);
+  return out;
+}
+
+std::vector<std::uint8_t> encodeJournalRecord(const JournalRecord &record) {
+  std::vector<std::uint8_t> payload;
+  ByteWriter p(payload);
+  p.svarint(record.turn_counter);
+  p.svarint(record.depth);
+
+  std::uint32_t prev = 0;
+  p.varint(record.tiles.size());
+  for (const auto &[cell, tile] : record.tiles) {
+    writeCell(p, cell, prev);
+    p.u8(static_cast<std::uint8_t>(tile));
+  }
+
+  prev = 0;
+  p.varint(record.discovered.size());
+  for (const std::uint32_t cell : record.discovered)
+    writeCell(p, cell, prev);
+
+  p.varint(record.features.size());
+  for (const auto &[pos, feature] : record.features) {
+    p.svarint(pos.x);
+    p.svarint(pos.y);
+    if (feature)
+      writeFeature(p, *feature);
+    else
+      p.u8(FEATURE_REMOVED);
+  }
+
+  p.varint(record.removedEntities.size());
+  for (const std::uint32_t key : record.removedEntities)
+    p.varint(key);
+
+  p.varint(record.entities.size());
+  for (const auto &[key, entity] : record.entities) {
+    p.varint(key);
+    writeEntity(p, entity);
+  }
+
+  std::vector<std::uint8_t> out;
+  out.reserve(FRAME_SIZE + payload.size());
+  ByteWriter w(out);
+  w.u32(static_cast<std::uint32_t>(payload.size()));
+  w.u32(fnv1a(payload));
+  w.bytes(payload);
+  return out;
+}
+
+std::vector<JournalRecord> readJournal(std::span<const std::uint8_t> bytes,
+                                       std::uint64_t saveId) {
+  if (bytes.size() < HEADER_SIZE ||
+      std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error("Save journal: bad header");
+  ByteReader r(bytes);
+  r.bytes(sizeof(MAGIC));
+  const std::uint16_t version = r.u16();
+  if (version != SAVE_JOURNAL_VERSION)
+    throw std::runtime_error("Save journal: unsupported version " +
+                             std::to_string(version));
+  r.u16(); // reserved
+
+  std::vector<JournalRecord> records;
+  if (r.u64() != saveId)
+    return records; // stale: written for another base
+
+  // A torn or damaged record ends the journal
+  while (r.remaining() >= FRAME_SIZE) {
+    const std::uint32_t size = r.u32();
+    const std::uint32_t checksum = r.u32();
+    if (size > r.remaining())
+      break;
+    const auto payload = r.bytes(size);
+    if (fnv1a(payload) != checksum)
+      break;
+    try {
+      records.push_back(readRecord(payload));
+    } catch (const std::runtime_error &) {
+      break;
+    }
+  }
+  return records;
+}
+
+std::vector<JournalRecord> readJournalFile(const std::string &filename,
+                                           std::uint64_t saveId) {
+  std::ifstream file(journalFilename(filename), std::ios::binary);
+  if (!file.is_open())
+    return {};
+  const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(file),
+                                        std::istreambuf_iterator<char>()};
+  return readJournal(bytes, saveId);
+}
+
+void applyJournal(LevelState &level, std::span<const JournalRecord> records) {
+  world::Map &map = level.map;
+  const std::size_t cells = map.tiles().size();
+  const auto width = static_cast<std::uint32_t>(map.width());
+  auto position = [&](std::uint32_t cell) {
+    if (cell >= cells)
+      throw std::runtime_error("Save journal: cell out of range");
+    return core::Position{static_cast<int>(cell % width),
+                          static_cast<int>(cell / width)};
+  };
+
+  // Journal key -> live entity; base entities are keyed in load order
+  std::unordered_map<std::uint32_t, core::EntityId> keys;
+  const auto &loaded = level.entities.getEntities();
+  for (std::size_t i = 0; i < loaded.size(); ++i)
+    keys.emplace(static_cast<std::uint32_t>(i), loaded[i]->getId());
+
+  for (const JournalRecord &record : records) {
+    if (record.depth != level.depth)
+      continue;
+    for (const auto &[cell, tile] : record.tiles)
+      map.set(position(cell), tile);
+    if (!record.discovered.empty()) {
+      level.discovered.resize(cells);
+      for (const std::uint32_t cell : record.discovered) {
+        position(cell); // range check
+        level.discovered[cell] = true;
+      }
+    }
+    for (const auto &[pos, feature] : record.features) {
+      if (feature)
+        level.features.addFeature(pos, *feature);
+      else
+        level.features.removeFeature(pos);
+    }
+    for (const std::uint32_t key : record.removedEntities) {
+      if (auto it = keys.find(key); it != keys.end()) {
+        level.entities.removeEntity(it->second);
+        keys.erase(it);
+      }
+    }
+    for (const auto &[key, snap] : record.entities) {
+      if (auto it = keys.find(key); it != keys.end())
+        level.entities.removeEntity(it->second);
+      keys[key] = level.entities.addEntity(makeEntity(snap));
+    }
+  }
+}
+
+void applyJournal(SaveData &data, std::span<const JournalRecord> records) {
+  if (records.empty())
+    return;
+  for (LevelState &level : data.visited_levels)
+    applyJournal(level, records);
+  data.turn_counter = records.back().turn_counter;
+}
+
+std::size_t writeJournaledBase(const std::string &filename,
+                               const SaveSnapshot &snapshot,
+                               FsyncPolicy fsync) {
+  // Base first: if the journal reset is lost, the old journal's save_id
+  // no longer matches and it is ignored
+  const auto base = encodeBinary(snapshot);
+  writeFileAtomic(filename, base, fsync);
+  const auto header = encodeJournalHeader(snapshot.save_id);
+  writeFileAtomic(journalFilename(filename), header, fsync);
+  return base.size() + header.size();
+}
+
+std::size_t appendJournalRecord(const std::string &filename,
+                                const JournalRecord &record,
+                                FsyncPolicy fsync) {
+  const auto bytes = encodeJournalRecord(record);
+  appendToFile(journalFilename(filename), bytes, fsync);
+  return bytes.size();
+}
+
+} // namespace serialization
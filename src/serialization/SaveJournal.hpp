@@ -0,0 +1,78 @@
+#pragma once
+#include "AtomicFile.hpp"
+#include "Gameserialization.hpp"
+#include "SaveSnapshot.hpp"
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace serialization {
+
+// Append-only log of level deltas on top of a binary save (the base).
+// The journal lives next to the base as filename + ".journal":
+//
+//   Header  "RLJN", u16 version, u16 reserved, u64 save_id
+//   Records { u32 payload size, u32 FNV-1a of payload, payload }...
+//
+// save_id must match the base's (BinaryIndex::save_id), otherwise the
+// journal belongs to an older base and is ignored. Reading stops at the
+// first short or corrupt record, so a crash during an append loses only
+// that record.
+//
+// A record replaces state rather than patching it: tiles, discovered
+// cells and features hold their new values, entities are upserted whole
+// by key. Keys of the base's entities are 0..n-1 in save order; later
+// entities get fresh keys from DeltaTracker.
+constexpr std::uint16_t SAVE_JOURNAL_VERSION = 1;
+
+struct JournalRecord {
+  int turn_counter = 0;
+  int depth = 0;
+  std::vector<std::pair<std::uint32_t, world::Tile>> tiles; // row-major cell
+  std::vector<std::uint32_t> discovered; // newly discovered cells
+  // nullopt = feature removed
+  std::vector<std::pair<core::Position, std::optional<world::Feature>>>
+      features;
+  std::vector<std::uint32_t> removedEntities;
+  std::vector<std::pair<std::uint32_t, EntitySnapshot>> entities;
+
+  bool empty() const noexcept {
+    return tiles.empty() && discovered.empty() && features.empty() &&
+           removedEntities.empty() && entities.empty();
+  }
+};
+
+std::string journalFilename(const std::string &filename);
+
+std::vector<std::uint8_t> encodeJournalHeader(std::uint64_t saveId);
+// Framed record, ready to append
+std::vector<std::uint8_t> encodeJournalRecord(const JournalRecord &record);
+
+// Records of a journal belonging to saveId; empty if the header does not
+// match. Throws std::runtime_error only on a malformed header.
+std::vector<JournalRecord> readJournal(std::span<const std::uint8_t> bytes,
+                                       std::uint64_t saveId);
+// Same from filename's journal file; empty if there is none
+std::vector<JournalRecord> readJournalFile(const std::string &filename,
+                                           std::uint64_t saveId);
+
+// Applies the records for level.depth, in order. level must be freshly
+// decoded from the base (entity keys are its entity order).
+void applyJournal(LevelState &level, std::span<const JournalRecord> records);
+// Every level, plus the turn counter of the last record
+void applyJournal(SaveData &data, std::span<const JournalRecord> records);
+
+// Compaction: writes snapshot as the new base, then starts an empty
+// journal for its save_id. Returns the bytes written.
+std::size_t writeJournaledBase(const std::string &filename,
+                               const SaveSnapshot &snapshot,
+                               FsyncPolicy fsync = FsyncPolicy::File);
+// Returns the bytes appended
+std::size_t appendJournalRecord(const std::string &filename,
+                                const JournalRecord &record,
+                                FsyncPolicy fsync = FsyncPolicy::File);
+
+} // namespace serialization
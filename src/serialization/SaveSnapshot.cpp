@@ -0,0 +1,57 @@
+#include "SaveSnapshot.hpp"
+#include <algorithm>
+
+namespace serialization {
+
+EntitySnapshot snapshotEntity(const entities::Entity &entity) {
+  EntitySnapshot snap;
+  snap.name = entity.getName();
+  snap.position = entity.getPosition();
+  snap.glyph = entity.getGlyph();
+  const auto properties = entity.getAllProperties();
+  snap.properties.assign(properties.begin(), properties.end());
+  std::sort(snap.properties.begin(), snap.properties.end());
+  snap.hasAI = entity.hasAI();
+  return snap;
+}
+
+LevelSnapshot snapshotLevel(const world::Map &map,
+                            const world::FeatureManager &features,
+                            const entities::EntityManager &entities,
+                            std::vector<bool> discovered, int depth) {
+  LevelSnapshot level;
+  level.width = map.width();
+  level.height = map.height();
+  level.tiles.assign(map.tiles().begin(), map.tiles().end());
+  level.discovered = std::move(discovered);
+  level.depth = depth;
+
+  const auto positions = features.getAllPositions();
+  level.features.reserve(positions.size());
+  for (const auto &pos : positions)
+    level.features.emplace_back(pos, *features.getFeature(pos));
+
+  level.entities.reserve(entities.count());
+  for (const auto &e : entities.getEntities()) {
+    if (e)
+      level.entities.push_back(snapshotEntity(*e));
+  }
+  return level;
+}
+
+LevelSnapshot snapshotLevel(const LevelState &level) {
+  return snapshotLevel(level.map, level.features, level.entities,
+                       level.discovered, level.depth);
+}
+
+SaveSnapshot snapshotSave(const SaveData &data) {
+  SaveSnapshot snapshot;
+  snapshot.current_level_index = data.current_level_index;
+  snapshot.turn_counter = data.turn_counter;
+  snapshot.levels.reserve(data.visited_levels.size());
+  for (const auto &level : data.visited_levels)
+    snapshot.levels.push_back(snapshotLevel(level));
+  return snapshot;
+}
+
+} // namespace serialization
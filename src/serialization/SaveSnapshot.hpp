@@ -0,0 +1,54 @@
+#pragma once
+#include "Gameserialization.hpp"
+#include "core/Position.hpp"
+#include "world/Feature.hpp"
+#include "world/Tile.hpp"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace serialization {
+
+// Plain copy of one entity: no AI object, no owning manager.
+// properties are sorted by key, so equal entities compare equal.
+struct EntitySnapshot {
+  std::string name;
+  core::Position position;
+  char glyph = '?';
+  std::vector<std::pair<std::string, int>> properties;
+  bool hasAI = false;
+
+  bool operator==(const EntitySnapshot &) const = default;
+};
+
+// What the binary encoder needs from one level, detached from the live
+// Map / FeatureManager / EntityManager. Taking one costs a copy of the
+// tile bytes and the entity list, so the game thread can snapshot and
+// let another thread encode while play continues.
+struct LevelSnapshot {
+  int width = 0;
+  int height = 0;
+  std::vector<world::Tile> tiles; // row-major
+  std::vector<bool> discovered;   // parallel to tiles
+  std::vector<std::pair<core::Position, world::Feature>> features;
+  std::vector<EntitySnapshot> entities;
+  int depth = 0;
+};
+
+struct SaveSnapshot {
+  std::vector<LevelSnapshot> levels;
+  int current_level_index = 0;
+  int turn_counter = 0;
+  std::uint64_t save_id = 0; // see BINARY_SAVE_VERSION
+};
+
+EntitySnapshot snapshotEntity(const entities::Entity &entity);
+LevelSnapshot snapshotLevel(const world::Map &map,
+                            const world::FeatureManager &features,
+                            const entities::EntityManager &entities,
+                            std::vector<bool> discovered, int depth);
+LevelSnapshot snapshotLevel(const LevelState &level);
+SaveSnapshot snapshotSave(const SaveData &data);
+
+} // namespace serialization
@@ -0,0 +1,383 @@
+#include "Simulation.hpp"
+#include "actions/MoveAction.hpp"
+#include "ai/SimpleAI.hpp"
+#include "config/DungeonConfig.hpp"
+#include "entities/ActorStore.hpp"
+#include "entities/Entity.hpp"
+#include "core/BitGrid.hpp"
+#include "core/ThreadPool.hpp"
+#include "serialization/AutosaveService.hpp"
+#include "systems/ActorSystems.hpp"
+#include "world/FeatureProperties.hpp"
+#include "world/TileRegistry.hpp"
+#include "world/gen/LevelGenerator.hpp"
+#include "world/gen/LevelPregenerator.hpp"
+#include <algorithm>
+#include <array>
+
+namespace sim {
+
+namespace {
+constexpr int VISION_RADIUS = 8;
+
+constexpr std::array<core::Position, 8> DIRECTIONS = {{
+    {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}}};
+
+// Arena: energy spent per step, hazard damage per turn, crowd stats
+constexpr int ARENA_ACTION_COST = 100;
+constexpr int ARENA_HAZARD_DAMAGE = 1;
+constexpr int ARENA_HP = 20;
+constexpr double ARENA_HAZARD_SHARE = 0.125;
+
+void spawnArenaActor(entities::ActorStore &actors,
+                     const std::vector<core::Position> &floor,
+                     core::Rng &rng) {
+  const core::EntityId id =
+      actors.create(entities::CPosition | entities::CHealth |
+                    entities::CSpeed | entities::CGlyph);
+  const std::size_t i = actors.indexOf(id);
+  actors.positions()[i] = floor[rng.uniformIndex(floor.size())];
+  actors.hp()[i] = ARENA_HP;
+  actors.maxHp()[i] = ARENA_HP;
+  actors.speed()[i] = rng.uniformInt(50, 150);
+  actors.glyphs()[i] = 'r';
+}
+
+// Shallow liquid scalds for the length of an arena run, then reverts
+class ScaldingLiquid {
+public:
+  ScaldingLiquid()
+      : saved_(world::TileRegistry::instance().getProperties(
+            world::Tile::ShallowLiquid)) {
+    world::TileProperties hot = saved_;
+    hot.damage_per_turn = ARENA_HAZARD_DAMAGE;
+    world::TileRegistry::instance().registerTile(world::Tile::ShallowLiquid,
+                                                 hot);
+  }
+  ~ScaldingLiquid() {
+    world::TileRegistry::instance().registerTile(world::Tile::ShallowLiquid,
+                                                 saved_);
+  }
+  ScaldingLiquid(const ScaldingLiquid &) = delete;
+  ScaldingLiquid &operator=(const ScaldingLiquid &) = delete;
+
+private:
+  world::TileProperties saved_;
+};
+} // namespace
+
+ArenaReport runArena(const SimConfig &config, std::size_t actors) {
+  ArenaReport report;
+  report.actors = actors;
+  const ScaldingLiquid hazard;
+
+  config::LevelConfig levelConfig = config::largeDungeon();
+  levelConfig.monster_count = 0;
+  world::LevelGenerator generator(core::Rng(config.seed).fork("levels"));
+  world::LevelData level = generator.generateLevel(
+      config.width, config.height, config.depth, levelConfig);
+  world::Map &map = *level.map;
+  core::Rng rng = core::Rng(config.seed).fork("arena");
+
+  std::vector<core::Position> floor;
+  for (int y = 0; y < map.height(); ++y) {
+    for (int x = 0; x < map.width(); ++x) {
+      if (!map.isPassable(x, y))
+        continue;
+      floor.push_back({x, y});
+      if (map.at({x, y}) == world::Tile::OpenGround &&
+          rng.chance(ARENA_HAZARD_SHARE)) {
+        map.set({x, y}, world::Tile::ShallowLiquid);
+        ++report.hazardCells;
+      }
+    }
+  }
+  if (floor.empty())
+    return report;
+
+  entities::ActorStore crowd;
+  crowd.reserve(actors);
+  for (std::size_t n = 0; n < actors; ++n)
+    spawnArenaActor(crowd, floor, rng);
+
+  std::vector<core::EntityId> killed;
+  const auto start = std::chrono::steady_clock::now();
+  for (; report.turns < config.turns; ++report.turns) {
+    auto t0 = std::chrono::steady_clock::now();
+    const std::size_t ready =
+        systems::ActorSystems::accumulateEnergy(crowd, ARENA_ACTION_COST);
+    auto t1 = std::chrono::steady_clock::now();
+    report.energy += t1 - t0;
+
+    if (ready > 0) {
+      auto positions = crowd.positions();
+      auto energy = crowd.energy();
+      for (std::size_t i = 0; i < energy.size(); ++i) {
+        if (energy[i] < ARENA_ACTION_COST)
+          continue;
+        const core::Position next =
+            positions[i] + DIRECTIONS[rng.uniformIndex(DIRECTIONS.size())];
+        if (map.isPassable(next.x, next.y))
+          positions[i] = next;
+        energy[i] -= ARENA_ACTION_COST; // a blocked step is a wait
+        ++report.actorTurns;
+      }
+    }
+    t0 = std::chrono::steady_clock::now();
+    report.moves += t0 - t1;
+
+    killed.clear();
+    systems::ActorSystems::applyTerrainDamage(crowd, map, killed);
+    for (const core::EntityId &id : killed) {
+      crowd.destroy(id);
+      spawnArenaActor(crowd, floor, rng);
+    }
+    report.deaths += killed.size();
+    report.damage += std::chrono::steady_clock::now() - t0;
+  }
+  report.elapsed = std::chrono::steady_clock::now() - start;
+  return report;
+}
+
+BatchReport runBatch(const SimConfig &config, std::uint64_t levels,
+                     std::size_t threads) {
+  BatchReport report;
+  const auto start = std::chrono::steady_clock::now();
+
+  config::LevelConfig levelConfig = config::largeDungeon();
+  levelConfig.monster_count = config.monsters;
+  core::ThreadPool pool(threads);
+  // Two jobs in flight per worker keeps every core busy while the
+  // consumer inspects the previous level
+  world::LevelPregenerator pregen(pool, config.seed, config.width,
+                                  config.height, levelConfig,
+                                  static_cast<int>(2 * pool.size()));
+
+  for (std::uint64_t i = 0; i < levels; ++i) {
+    const int depth = config.depth + static_cast<int>(i);
+    const world::LevelData level = pregen.take(depth);
+
+    for (int y = 0; y < level.map->height(); ++y)
+      for (int x = 0; x < level.map->width(); ++x)
+        if (!level.map->blocksMovement({x, y}))
+          ++report.floorCells;
+
+    std::uint64_t stairs = 0;
+    for (const auto &pos : level.features->getAllPositions()) {
+      const world::Feature *f = level.features->getFeature(pos);
+      if (f && world::isStairs(*f))
+        ++stairs;
+    }
+    report.stairs += stairs;
+    report.noStairs += stairs == 0 ? 1 : 0;
+    report.monsterSpawns += level.monster_spawns.size();
+    ++report.levels;
+  }
+
+  pregen.cancelAll();
+  report.elapsed = std::chrono::steady_clock::now() - start;
+  return report;
+}
+
+Simulation::Simulation(const SimConfig &config)
+    : config_(config), levelRng_(core::Rng(config.seed).fork("levels")),
+      policyRng_(core::Rng(config.seed).fork("player")) {
+  if (config_.autosaveEvery > 0)
+    autosave_ = std::make_unique<serialization::AutosaveService>(
+        config_.autosavePath);
+}
+
+Simulation::~Simulation() = default;
+
+SimReport Simulation::run() {
+  report_ = {};
+  const auto start = std::chrono::steady_clock::now();
+
+  generateLevel();
+  while (report_.turns < config_.turns) {
+    playerTurn();
+    ++report_.turns;
+
+    turnMgr_->processTurn(); // player's turn, as Game::processPlayerTurn
+    processAITurns();
+
+    if (playerDied_) {
+      ++report_.playerDeaths;
+      generateLevel();
+      continue;
+    }
+    fov_->compute(player()->getPosition(), VISION_RADIUS);
+
+    if (autosave_) {
+      if (report_.turns % config_.autosaveEvery == 0)
+        autosavePending_ = true;
+      if (autosavePending_)
+        autosave();
+    }
+  }
+
+  report_.elapsed = std::chrono::steady_clock::now() - start;
+  if (autosave_) {
+    autosave_->wait(); // outside the timed run
+    report_.autosaves = autosave_->saved();
+    report_.autosavesFailed = autosave_->failed();
+    report_.autosaveCompactions = autosave_->compactions();
+    report_.autosaveBytes = autosave_->bytesWritten();
+  }
+  return report_;
+}
+
+void Simulation::generateLevel() {
+  const auto start = std::chrono::steady_clock::now();
+
+  config::LevelConfig levelConfig = config::largeDungeon();
+  levelConfig.monster_count = config_.monsters;
+  world::LevelGenerator generator(levelRng_.stream(report_.levels));
+  world::LevelData levelData = generator.generateLevel(
+      config_.width, config_.height, config_.depth, levelConfig);
+
+  // Old entities reference the old map through their AI - drop them first
+  turnMgr_ = std::make_unique<entities::TurnManager>();
+  entityMgr_ = std::make_unique<entities::EntityManager>(config_.width,
+                                                         config_.height);
+  map_ = std::move(levelData.map);
+  featureMgr_ = std::move(levelData.features);
+  mapView_ = std::make_unique<world::MapViewAdapter>(*map_);
+  levelView_ = std::make_unique<world::LevelView>(*map_, *featureMgr_);
+
+  entities::Entity &hero =
+      entityMgr_->createEntity("Player", levelData.player_spawn);
+  hero.setMaxHP(100);
+  hero.setHP(100);
+  hero.set(entities::Prop::Speed, 100);
+  hero.set(entities::Prop::Str, 10);
+  hero.setGlyph('@');
+  playerId_ = hero.getId();
+  turnMgr_->addEntity(hero);
+  playerDied_ = false;
+
+  chaseMap_ =
+      std::make_unique<core::BasicDijkstraMap<world::LevelView>>(*levelView_);
+  chaseTarget_ = levelData.player_spawn;
+  chaseMap_->addGoal(chaseTarget_);
+  chaseMap_->compute();
+
+  for (const auto &monsterPos : levelData.monster_spawns) {
+    entities::Entity &monster =
+        entityMgr_->createEntity("Goblin", monsterPos);
+    monster.setMaxHP(30);
+    monster.setHP(20);
+    monster.set(entities::Prop::Str, 2);
+    monster.set(entities::Prop::PhysRes, 2);
+    monster.set(entities::Prop::Speed, 100);
+    monster.setGlyph('g');
+    auto ai = std::make_unique<ai::SimpleAI>(VISION_RADIUS);
+    ai->setChaseMap(chaseMap_.get());
+    monster.setAI(std::move(ai));
+    turnMgr_->addEntity(monster);
+  }
+
+  fov_ = std::make_unique<core::FOV>(*mapView_);
+  fov_->compute(hero.getPosition(), VISION_RADIUS);
+  if (autosave_)
+    autosave_->levelChanged();
+
+  ++report_.levels;
+  report_.generation += std::chrono::steady_clock::now() - start;
+}
+
+void Simulation::autosave() {
+  const auto start = std::chrono::steady_clock::now();
+  if (autosave_->busy()) {
+    ++report_.autosavesDeferred; // try again next turn
+  } else if (config_.autosaveFull) {
+    serialization::SaveSnapshot snapshot;
+    snapshot.turn_counter = static_cast<int>(report_.turns);
+    snapshot.levels.push_back(serialization::snapshotLevel(
+        *map_, *featureMgr_, *entityMgr_,
+        std::vector<bool>(map_->tiles().size()), config_.depth));
+    autosave_->submit(std::move(snapshot));
+    autosavePending_ = false;
+  } else {
+    // No exploration memory in the sim: nothing discovered to journal
+    autosave_->submitLevel(*map_, *featureMgr_, *entityMgr_, core::BitGrid{},
+                           config_.depth, static_cast<int>(report_.turns));
+    autosavePending_ = false;
+  }
+  const auto spent = std::chrono::steady_clock::now() - start;
+  report_.autosaveGameThread += spent;
+  report_.autosaveMaxPause = std::max(report_.autosaveMaxPause, spent);
+}
+
+entities::Entity *Simulation::player() const {
+  return entityMgr_->get(playerId_);
+}
+
+void Simulation::playerTurn() {
+  entities::Entity &hero = *player();
+  const core::Position pos = hero.getPosition();
+  const std::size_t before = entityMgr_->count();
+
+  // Fight back if something is adjacent
+  core::Position target = pos;
+  for (const core::Position &dir : DIRECTIONS) {
+    entities::Entity *other = entityMgr_->getEntityAt(pos + dir);
+    if (other && other != &hero) {
+      target = pos + dir;
+      break;
+    }
+  }
+
+  // Otherwise wander: random direction, retried a few times if blocked
+  if (target == pos) {
+    for (int attempt = 0; attempt < 8; ++attempt) {
+      const core::Position next =
+          pos + DIRECTIONS[policyRng_.uniformIndex(DIRECTIONS.size())];
+      if (!map_->blocksMovement(next) && !featureMgr_->blocksMovement(next)) {
+        target = next;
+        break;
+      }
+    }
+  }
+
+  if (target != pos) {
+    actions::MoveAction move(hero, target);
+    move.execute(*map_, *featureMgr_, *entityMgr_, *turnMgr_);
+  }
+  report_.monstersKilled += before - entityMgr_->count();
+}
+
+void Simulation::processAITurns() {
+  // Same flow as Game::processAITurns
+  const core::Position playerPos = player()->getPosition();
+  if (playerPos != chaseTarget_) {
+    chaseTarget_ = playerPos;
+    chaseMap_->clearGoals();
+    chaseMap_->addGoal(chaseTarget_);
+    chaseMap_->compute();
+  }
+
+  while (!turnMgr_->isEmpty()) {
+    const core::EntityId actorId = turnMgr_->getNextActor();
+    if (actorId == playerId_) {
+      break;
+    }
+
+    entities::Entity *actor = entityMgr_->get(actorId);
+
+    if (actor->hasAI()) {
+      actor->getAI()->act(*actor, *player(), *map_, *featureMgr_,
+                          *entityMgr_, *turnMgr_);
+      ++report_.actorTurns;
+
+      if (!entityMgr_->contains(playerId_)) {
+        playerDied_ = true;
+        return;
+      }
+    }
+
+    turnMgr_->processTurn();
+  }
+}
+
+} // namespace sim
@@ -0,0 +1,134 @@
+#pragma once
+#include "core/DijkstraMap.hpp"
+#include "core/EntityId.hpp"
+#include "core/FOV.hpp"
+#include "core/Rng.hpp"
+#include "entities/EntityManager.hpp"
+#include "entities/TurnManager.hpp"
+#include "world/FeatureManager.hpp"
+#include "world/Map.hpp"
+#include "world/LevelView.hpp"
+#include "world/MapViewAdapter.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace serialization {
+class AutosaveService;
+}
+
+namespace sim {
+
+// Parameters of a headless run
+struct SimConfig {
+  int width = 60;
+  int height = 40;
+  int depth = 1;
+  int monsters = 20;               // spawn points requested per level
+  std::uint64_t turns = 1000;      // player turns to simulate
+  std::uint64_t seed = 1;          // level generation + player policy
+  std::uint64_t autosaveEvery = 0; // player turns between autosaves, 0 = off
+  std::string autosavePath = "rl_sim_autosave.sav";
+  bool autosaveFull = false; // full snapshots instead of the journal
+};
+
+// Counters collected by Simulation::run()
+struct SimReport {
+  std::uint64_t turns = 0;        // player turns
+  std::uint64_t actorTurns = 0;   // AI turns processed
+  std::uint64_t levels = 0;       // levels generated
+  std::uint64_t playerDeaths = 0; // each one regenerates the level
+  std::uint64_t monstersKilled = 0;
+  std::chrono::steady_clock::duration elapsed{};    // whole run
+  std::chrono::steady_clock::duration generation{}; // part spent in levelgen
+  // Autosave (--autosave N): game-thread cost is snapshot + hand-off only
+  std::uint64_t autosaves = 0;         // written
+  std::uint64_t autosavesDeferred = 0; // turns a due save waited for worker
+  std::uint64_t autosavesFailed = 0;
+  std::uint64_t autosaveCompactions = 0; // full saves among autosaves
+  std::uint64_t autosaveBytes = 0;
+  std::chrono::steady_clock::duration autosaveGameThread{}; // total
+  std::chrono::steady_clock::duration autosaveMaxPause{};   // worst turn
+};
+
+// Level generation throughput and sanity counters over many depths
+struct BatchReport {
+  std::uint64_t levels = 0;
+  std::uint64_t floorCells = 0; // walkable tiles, summed
+  std::uint64_t stairs = 0;
+  std::uint64_t monsterSpawns = 0;
+  std::uint64_t noStairs = 0; // levels the player could not leave
+  std::chrono::steady_clock::duration elapsed{};
+};
+
+// Bulk-actor stress run (--arena N) over entities::ActorStore
+struct ArenaReport {
+  std::uint64_t turns = 0;
+  std::uint64_t actors = 0;     // crowd size, kept constant by respawns
+  std::uint64_t actorTurns = 0; // ready actors that spent their energy
+  std::uint64_t deaths = 0;     // killed by terrain damage
+  std::uint64_t hazardCells = 0;
+  std::chrono::steady_clock::duration elapsed{}; // excluding level setup
+  std::chrono::steady_clock::duration energy{};  // accumulateEnergy
+  std::chrono::steady_clock::duration moves{};   // random steps of the ready
+  std::chrono::steady_clock::duration damage{};  // applyTerrainDamage
+};
+
+// `actors` simple monsters in an ActorStore on one generated level
+// (config.width x config.height, seed), with about one floor cell in
+// eight turned into scalding shallow liquid. Each of config.turns runs
+// ActorSystems::accumulateEnergy, a random step for every ready actor
+// and ActorSystems::applyTerrainDamage; the dead respawn elsewhere. No
+// player, AI objects or occupancy - it measures the batch systems alone.
+ArenaReport runArena(const SimConfig &config, std::size_t actors);
+
+// Generates `levels` consecutive depths (from config.depth, master seed
+// config.seed) through world::LevelPregenerator on `threads` workers
+// (0 = all cores), consuming them in order like a player descending.
+BatchReport runBatch(const SimConfig &config, std::uint64_t levels,
+                     std::size_t threads);
+
+// Game loop without input or rendering: the player is driven by a
+// random policy (bump-attack an adjacent monster, else a random step)
+// through MoveAction, monsters through the same AI/TurnManager path as
+// Game. Used to measure engine throughput.
+class Simulation {
+public:
+  explicit Simulation(const SimConfig &config);
+  ~Simulation();
+
+  SimReport run();
+
+private:
+  void generateLevel();
+  void playerTurn();
+  void processAITurns();
+  void autosave();
+  // nullptr once the player is dead
+  entities::Entity *player() const;
+
+  SimConfig config_;
+  core::Rng levelRng_;  // stream(n) generates the n-th level
+  core::Rng policyRng_; // random player moves
+  SimReport report_;
+
+  std::unique_ptr<world::Map> map_;
+  std::unique_ptr<world::FeatureManager> featureMgr_;
+  std::unique_ptr<world::MapViewAdapter> mapView_;
+  std::unique_ptr<core::FOV> fov_;
+  std::unique_ptr<world::LevelView> levelView_;
+  std::unique_ptr<core::BasicDijkstraMap<world::LevelView>> chaseMap_;
+  core::Position chaseTarget_;
+  std::unique_ptr<entities::EntityManager> entityMgr_;
+  std::unique_ptr<entities::TurnManager> turnMgr_;
+
+  core::EntityId playerId_; // resolved through player()
+  bool playerDied_ = false;
+
+  std::unique_ptr<serialization::AutosaveService> autosave_;
+  bool autosavePending_ = false; // due, but the previous save was in flight
+};
+
+} // namespace sim
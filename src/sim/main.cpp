@@ -0,0 +1,241 @@
+#include "core/Profiler.hpp"
+#include "sim/Simulation.hpp"
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+
+// Allocation counting: every global operator new in this binary bumps
+// a counter, so the report can show allocations per turn.
+namespace {
+std::atomic<std::uint64_t> g_allocations{0};
+
+void *countedAlloc(std::size_t size) {
+  g_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size == 0 ? 1 : size))
+    return p;
+  throw std::bad_alloc();
+}
+} // namespace
+
+void *operator new(std::size_t size) { return countedAlloc(size); }
+void *operator new[](std::size_t size) { return countedAlloc(size); }
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete[](void *p) noexcept { std::free(p); }
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void *p, std::size_t) noexcept { std::free(p); }
+
+namespace {
+
+void printUsage() {
+  std::cout << "usage: rl_sim [--width N] [--height N] [--depth N]\n"
+               "              [--monsters N] [--turns N] [--seed N]\n"
+               "              [--autosave TURNS [--autosave-full]]\n"
+               "              [--no-profile]\n"
+               "       rl_sim --arena ACTORS [--turns N] [--width N]\n"
+               "              [--height N] [--depth N] [--seed N]\n"
+               "       rl_sim --batch LEVELS [--threads N] [--width N]\n"
+               "              [--height N] [--depth N] [--monsters N]\n"
+               "              [--seed N]\n";
+}
+
+// Option ranges; anything outside is rejected rather than narrowed
+constexpr int MIN_SIDE = 8;
+constexpr int MAX_SIDE = 1 << 15; // binary save format limit
+constexpr int MAX_DEPTH = 1 << 20;
+constexpr int MAX_MONSTERS = 1 << 20;
+constexpr std::uint64_t U64_MIN = 0;
+constexpr std::uint64_t U64_MAX = ~std::uint64_t{0};
+constexpr std::uint64_t MAX_BATCH = 1 << 20;
+constexpr std::size_t MAX_ARENA = std::size_t{1} << 26;
+constexpr std::size_t MAX_THREADS = 1024;
+
+// Whole argument as a decimal in [lo, hi]; out is left alone otherwise
+template <typename T>
+bool parseValue(std::string_view text, T lo, T hi, T &out) {
+  T value{};
+  const char *end = text.data() + text.size();
+  const auto [ptr, ec] = std::from_chars(text.data(), end, value);
+  if (ec != std::errc{} || ptr != end || value < lo || value > hi)
+    return false;
+  out = value;
+  return true;
+}
+
+double toMs(std::chrono::steady_clock::duration d) {
+  return std::chrono::duration<double, std::milli>(d).count();
+}
+
+int batchMain(const sim::SimConfig &config, std::uint64_t levels,
+              std::size_t threads) {
+  const sim::BatchReport report = sim::runBatch(config, levels, threads);
+  const double ms = toMs(report.elapsed);
+  const double n = static_cast<double>(report.levels);
+  const double cells = static_cast<double>(config.width) *
+                       static_cast<double>(config.height);
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "batch: " << report.levels << " levels " << config.width << "x"
+            << config.height << " from depth " << config.depth << ", seed "
+            << config.seed << ", "
+            << (threads == 0 ? std::thread::hardware_concurrency()
+                             : static_cast<unsigned>(threads))
+            << " threads\n";
+  std::cout << "time:         " << ms << " ms\n";
+  std::cout << "levels/sec:   " << (ms > 0 ? n * 1000.0 / ms : 0.0) << "\n";
+  if (report.levels > 0) {
+    std::cout << "floor:        "
+              << 100.0 * static_cast<double>(report.floorCells) / (n * cells)
+              << " % of tiles\n";
+    std::cout << "stairs:       " << static_cast<double>(report.stairs) / n
+              << " per level (" << report.noStairs << " levels without)\n";
+    std::cout << "spawns:       "
+              << static_cast<double>(report.monsterSpawns) / n
+              << " monsters per level\n";
+  }
+  return report.noStairs == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int arenaMain(const sim::SimConfig &config, std::size_t actors) {
+  const sim::ArenaReport report = sim::runArena(config, actors);
+  const double ms = toMs(report.elapsed);
+  const double actorTurns = static_cast<double>(report.actorTurns);
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "arena: " << report.actors << " actors on " << config.width
+            << "x" << config.height << ", seed " << config.seed << ", "
+            << report.hazardCells << " hazard cells\n";
+  std::cout << "turns:        " << report.turns << " (" << report.actorTurns
+            << " actor turns, " << report.deaths << " deaths)\n";
+  std::cout << "time:         " << ms << " ms (energy "
+            << toMs(report.energy) << ", moves " << toMs(report.moves)
+            << ", terrain damage " << toMs(report.damage) << ")\n";
+  std::cout << "ns/actor turn: "
+            << (actorTurns > 0 ? ms * 1e6 / actorTurns : 0.0) << "\n";
+  return EXIT_SUCCESS;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  sim::SimConfig config;
+  bool profile = true;
+  std::uint64_t batchLevels = 0; // > 0 selects batch level generation
+  std::size_t arenaActors = 0;    // > 0 selects the ActorStore arena
+  std::size_t threads = 0;
+
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--no-profile") {
+      profile = false;
+      continue;
+    }
+    if (arg == "--autosave-full") {
+      config.autosaveFull = true;
+      continue;
+    }
+    if (arg == "--help" || i + 1 >= argc) {
+      printUsage();
+      return arg == "--help" ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    const std::string_view text = argv[++i];
+    bool ok = false;
+    if (arg == "--width") {
+      ok = parseValue(text, MIN_SIDE, MAX_SIDE, config.width);
+    } else if (arg == "--height") {
+      ok = parseValue(text, MIN_SIDE, MAX_SIDE, config.height);
+    } else if (arg == "--depth") {
+      ok = parseValue(text, 1, MAX_DEPTH, config.depth);
+    } else if (arg == "--monsters") {
+      ok = parseValue(text, 0, MAX_MONSTERS, config.monsters);
+    } else if (arg == "--turns") {
+      ok = parseValue(text, U64_MIN, U64_MAX, config.turns);
+    } else if (arg == "--seed") {
+      ok = parseValue(text, U64_MIN, U64_MAX, config.seed);
+    } else if (arg == "--batch") {
+      ok = parseValue(text, U64_MIN, MAX_BATCH, batchLevels);
+    } else if (arg == "--arena") {
+      ok = parseValue(text, std::size_t{0}, MAX_ARENA, arenaActors);
+    } else if (arg == "--autosave") {
+      ok = parseValue(text, U64_MIN, U64_MAX, config.autosaveEvery);
+    } else if (arg == "--threads") {
+      ok = parseValue(text, std::size_t{0}, MAX_THREADS, threads);
+    } else {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+    if (!ok) {
+      std::cerr << "rl_sim: invalid value for " << arg << ": " << text
+                << "\n";
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (batchLevels > 0)
+    return batchMain(config, batchLevels, threads);
+  if (arenaActors > 0)
+    return arenaMain(config, arenaActors);
+
+  core::Profiler::setEnabled(profile);
+  core::Profiler::reset();
+
+  sim::Simulation simulation(config);
+  const std::uint64_t allocsBefore = g_allocations.load();
+  const sim::SimReport report = simulation.run();
+  const std::uint64_t allocs = g_allocations.load() - allocsBefore;
+
+  const double totalMs = toMs(report.elapsed);
+  const double simMs = totalMs - toMs(report.generation);
+  const double turns = static_cast<double>(report.turns);
+
+  std::cout << std::fixed << std::setprecision(2);
+  std::cout << "map " << config.width << "x" << config.height << ", "
+            << config.monsters << " monsters, seed " << config.seed << "\n";
+  std::cout << "turns:        " << report.turns << " player, "
+            << report.actorTurns << " AI\n";
+  std::cout << "levels:       " << report.levels << " ("
+            << report.playerDeaths << " player deaths, "
+            << report.monstersKilled << " monsters killed)\n";
+  std::cout << "time:         " << totalMs << " ms (" << toMs(report.generation)
+            << " ms level generation)\n";
+  std::cout << "turns/sec:    " << (simMs > 0 ? turns * 1000.0 / simMs : 0.0)
+            << " (excluding generation)\n";
+  std::cout << "allocs/turn:  "
+            << (turns > 0 ? static_cast<double>(allocs) / turns : 0.0)
+            << " (including generation)\n";
+  if (config.autosaveEvery > 0) {
+    std::cout << "autosave:     " << report.autosaves << " saves to "
+              << config.autosavePath << " (" << report.autosavesDeferred
+              << " deferred turns, " << report.autosavesFailed
+              << " failed)\n";
+    std::cout << "  " << (config.autosaveFull ? "full snapshots" : "journal")
+              << ", " << report.autosaveCompactions << " compactions, "
+              << report.autosaveBytes / 1024 << " KiB written\n";
+    std::cout << "  game thread " << toMs(report.autosaveGameThread)
+              << " ms total, max pause "
+              << toMs(report.autosaveMaxPause) << " ms\n";
+  }
+
+  if (profile) {
+    std::cout << "\nsubsystem        total ms   % of sim      calls\n";
+    for (std::size_t b = 0; b < core::PROFILE_BUCKET_COUNT; ++b) {
+      const auto bucket = static_cast<core::ProfileBucket>(b);
+      const double ms = toMs(core::Profiler::total(bucket));
+      std::cout << std::left << std::setw(14)
+                << core::profileBucketName(bucket) << std::right
+                << std::setw(11) << ms << std::setw(11)
+                << (simMs > 0 ? 100.0 * ms / simMs : 0.0) << std::setw(11)
+                << core::Profiler::calls(bucket) << "\n";
+    }
+    std::cout << "(AI includes the FOV/Pathfinding work done inside act())\n";
+  }
+  return EXIT_SUCCESS;
+}
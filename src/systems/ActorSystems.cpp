@@ -0,0 +1,59 @@
+#include "ActorSystems.hpp"
+#include "world/Map.hpp"
+#include "world/Tile.hpp"
+#include "world/TileProperties.hpp"
+#include <array>
+#include <cstddef>
+
+namespace systems {
+
+using entities::ActorStore;
+
+std::size_t ActorSystems::accumulateEnergy(ActorStore &actors, int threshold) {
+  auto masks = actors.masks();
+  auto speed = actors.speed();
+  auto energy = actors.energy();
+
+  std::size_t ready = 0;
+  for (std::size_t i = 0; i < masks.size(); ++i) {
+    if (!(masks[i] & entities::CSpeed))
+      continue;
+    energy[i] += speed[i];
+    ready += energy[i] >= threshold ? 1u : 0u;
+  }
+  return ready;
+}
+
+void ActorSystems::applyTerrainDamage(ActorStore &actors, const world::Map &map,
+                                      std::vector<core::EntityId> &killed) {
+  // Per-tile damage resolved once, not once per actor
+  std::array<int, world::TILE_COUNT> damage{};
+  bool anyDamage = false;
+  for (std::size_t t = 0; t < world::TILE_COUNT; ++t) {
+    damage[t] = world::getDamagePerTurn(static_cast<world::Tile>(t));
+    anyDamage = anyDamage || damage[t] != 0;
+  }
+  if (!anyDamage)
+    return;
+
+  constexpr entities::ComponentMask required =
+      entities::CPosition | entities::CHealth;
+  auto masks = actors.masks();
+  auto positions = actors.positions();
+  auto hp = actors.hp();
+  auto ids = actors.ids();
+
+  for (std::size_t i = 0; i < masks.size(); ++i) {
+    if ((masks[i] & required) != required || !map.inBounds(positions[i]))
+      continue;
+    const int dmg = damage[static_cast<std::size_t>(map.at(positions[i]))];
+    if (dmg == 0)
+      continue;
+    const bool wasAlive = hp[i] > 0;
+    hp[i] -= dmg;
+    if (wasAlive && hp[i] <= 0)
+      killed.push_back(ids[i]);
+  }
+}
+
+} // namespace systems
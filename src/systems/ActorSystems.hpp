@@ -0,0 +1,28 @@
+#pragma once
+#include "core/EntityId.hpp"
+#include "entities/ActorStore.hpp"
+#include <vector>
+
+namespace world {
+class Map;
+}
+
+namespace systems {
+
+// Batch systems over entities::ActorStore - each is one pass over the
+// component arrays it needs.
+class ActorSystems {
+public:
+  // Energy accumulation (same model as TurnManager): every actor with
+  // CSpeed gains speed energy. Returns number of actors with >= threshold.
+  static std::size_t accumulateEnergy(entities::ActorStore &actors,
+                                      int threshold = 100);
+
+  // TileProperties::damage_per_turn for every actor with CPosition and
+  // CHealth. Ids of actors whose hp drops to <= 0 are appended to killed.
+  static void applyTerrainDamage(entities::ActorStore &actors,
+                                 const world::Map &map,
+                                 std::vector<core::EntityId> &killed);
+};
+
+} // namespace systems
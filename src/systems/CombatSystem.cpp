@@ -15,15 +15,17 @@ int CombatSystem::calculateDamage(int str, float phys_res) {
 
 CombatSystem::AttackResult CombatSystem::meleeAttack(Entity &attacker,
                                                      Entity &defender) {
-  int str = attacker.getProperty("str");
-  float phys_res = static_cast<float>(defender.getProperty("phys_res")) /
+  using entities::Prop;
+
+  int str = attacker.get(Prop::Str);
+  float phys_res = static_cast<float>(defender.get(Prop::PhysRes)) /
                    100.0f; // Assume stored as percentage
 
   int damage = calculateDamage(str, phys_res);
 
-  int current_hp = defender.getProperty("hp");
+  int current_hp = defender.get(Prop::HP);
   int new_hp = current_hp - damage;
-  defender.setProperty("hp", new_hp);
+  defender.set(Prop::HP, new_hp);
 
   bool killed = (new_hp <= 0);
 
@@ -31,40 +31,37 @@ std::string GameViewPanel::render() const {
     return std::string(size, ' ');
   }
 
-  std::string output;
-
   int startX = cameraCenter_.x - bounds_.width / 2;
   int startY = cameraCenter_.y - bounds_.height / 2;
 
-  for (int y = 0; y < bounds_.height; ++y) {
-    for (int x = 0; x < bounds_.width; ++x) {
-      int worldX = startX + x;
-      int worldY = startY + y;
+  // Blank rows terminated by newline; only visible cells get filled in
+  const size_t rowLen = static_cast<size_t>(bounds_.width) + 1;
+  std::string output(rowLen * static_cast<size_t>(bounds_.height), ' ');
+  for (size_t r = 1; r <= static_cast<size_t>(bounds_.height); ++r)
+    output[r * rowLen - 1] = '\n';
 
-      if (!map_->inBounds({worldX, worldY}) ||
-          !fov_->isVisible(worldX, worldY)) {
-        output += ' ';
-        continue;
-      }
+  fov_->forEachVisibleInRect(
+      startX, startY, startX + bounds_.width - 1, startY + bounds_.height - 1,
+      [&](int worldX, int worldY) {
+        char &cell = output[static_cast<size_t>(worldY - startY) * rowLen +
+                            static_cast<size_t>(worldX - startX)];
 
-      // Cursor
-      if (cursor_ && cursor_->x == worldX && cursor_->y == worldY) {
-        output += 'X';
-        continue;
-      }
+        // Cursor
+        if (cursor_ && cursor_->x == worldX && cursor_->y == worldY) {
+          cell = 'X';
+          return;
+        }
 
-      // Entity
-      entities::Entity *ent = entities_->getEntityAt({worldX, worldY});
-      if (ent) {
-        output += ent->getGlyph();
-        continue;
-      }
+        // Entity
+        entities::Entity *ent = entities_->getEntityAt({worldX, worldY});
+        if (ent) {
+          cell = ent->getGlyph();
+          return;
+        }
 
-      // Tile
-      output += tileToChar(static_cast<int>(map_->at({worldX, worldY})));
-    }
-    output += '\n';
-  }
+        // Tile
+        cell = tileToChar(static_cast<int>(map_->at({worldX, worldY})));
+      });
 
   return output;
 }
@@ -1,12 +1,10 @@
 #pragma once
 #include "Panel.hpp"
+#include "core/FOV.hpp" // core::FOV is an alias, can't be forward-declared
 #include "core/Position.hpp"
 #include <memory>
 
 // Forward declarations
-namespace core {
-class FOV;
-}
 namespace world {
 class Map;
 }
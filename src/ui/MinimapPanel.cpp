@@ -6,7 +6,7 @@ namespace ui {
 MinimapPanel::MinimapPanel(int x, int y, int width, int height, int mapWidth,
                            int mapHeight)
     : bounds_{x, y, width, height}, mapWidth_(mapWidth), mapHeight_(mapHeight),
-      playerPos_{0, 0} {
+      discovered_(mapWidth, mapHeight), playerPos_{0, 0} {
 
   // Calculate scaling
   scaleX_ = std::max(1, mapWidth / (width - 2));
@@ -16,10 +16,15 @@ MinimapPanel::MinimapPanel(int x, int y, int width, int height, int mapWidth,
 PanelBounds MinimapPanel::getBounds() const { return bounds_; }
 
 void MinimapPanel::discover(const core::Position &pos) {
-  discoveredTiles_.insert({pos.x, pos.y});
+  discovered_.discover(pos.x, pos.y);
 }
 
-void MinimapPanel::clear() { discoveredTiles_.clear(); }
+void MinimapPanel::discoverNew(const world::ExplorationMemory &memory) {
+  memory.forEachNewlyDiscovered(
+      [this](int x, int y) { discovered_.discover(x, y); });
+}
+
+void MinimapPanel::clear() { discovered_.clear(); }
 
 std::string MinimapPanel::render() const {
   std::string output;
@@ -44,14 +49,8 @@ std::string MinimapPanel::render() const {
       }
 
       // Check if any tile in this scaled region is discovered
-      bool discovered = false;
-      for (int dx = 0; dx < scaleX_ && !discovered; ++dx) {
-        for (int dy = 0; dy < scaleY_ && !discovered; ++dy) {
-          if (discoveredTiles_.count({worldX + dx, worldY + dy})) {
-            discovered = true;
-          }
-        }
-      }
+      const bool discovered = discovered_.anyDiscoveredInRect(
+          worldX, worldY, worldX + scaleX_ - 1, worldY + scaleY_ - 1);
 
       output += discovered ? '.' : ' ';
     }
@@ -1,7 +1,7 @@
 #pragma once
 #include "Panel.hpp"
 #include "core/Position.hpp"
-#include <set>
+#include "world/ExplorationMemory.hpp"
 #include <vector>
 
 namespace ui {
@@ -17,6 +17,9 @@ public:
   // Mark tile as discovered
   void discover(const core::Position &pos);
 
+  // Applies the cells the level memory discovered in its last merge()
+  void discoverNew(const world::ExplorationMemory &memory);
+
   // Update player position
   void setPlayerPosition(const core::Position &pos) { playerPos_ = pos; }
 
@@ -27,7 +30,7 @@ private:
   PanelBounds bounds_;
   int mapWidth_;
   int mapHeight_;
-  std::set<std::pair<int, int>> discoveredTiles_;
+  world::ExplorationMemory discovered_;
   core::Position playerPos_;
 
   // Scale map to fit minimap
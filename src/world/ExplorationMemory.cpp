@@ -0,0 +1,94 @@
+#include "ExplorationMemory.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <span>
+#include <stdexcept>
+
+namespace world {
+
+namespace {
+
+using Word = core::BitGrid::Word;
+constexpr int WORD_BITS = core::BitGrid::WORD_BITS;
+
+} // namespace
+
+ExplorationMemory::ExplorationMemory(int width, int height)
+    : discovered_(width, height), fresh_(width, height) {}
+
+void ExplorationMemory::clear() noexcept {
+  discovered_.fill(false);
+  clearDelta();
+}
+
+void ExplorationMemory::clearDelta() noexcept {
+  fresh_.clearRect(freshMinX_, freshMinY_, freshMaxX_, freshMaxY_);
+  freshMinX_ = 0;
+  freshMinY_ = 0;
+  freshMaxX_ = -1;
+  freshMaxY_ = -1;
+  freshCount_ = 0;
+}
+
+std::size_t ExplorationMemory::merge(const core::BitGrid &visible, int x0,
+                                     int y0, int x1, int y1) {
+  assert(visible.width() == width() && visible.height() == height());
+  clearDelta();
+
+  x0 = std::max(x0, 0);
+  y0 = std::max(y0, 0);
+  x1 = std::min(x1, width() - 1);
+  y1 = std::min(y1, height() - 1);
+  if (x0 > x1 || y0 > y1)
+    return 0;
+
+  const std::size_t w0 = static_cast<std::size_t>(x0) / WORD_BITS;
+  const std::size_t w1 = static_cast<std::size_t>(x1) / WORD_BITS;
+  for (int y = y0; y <= y1; ++y) {
+    std::span<const Word> seen = visible.row(y);
+    std::span<Word> known = discovered_.row(y);
+    std::span<Word> fresh = fresh_.row(y);
+    for (std::size_t w = w0; w <= w1; ++w) {
+      const Word added = seen[w] & ~known[w];
+      known[w] |= added;
+      fresh[w] = added;
+      freshCount_ += static_cast<std::size_t>(std::popcount(added));
+    }
+  }
+
+  freshMinX_ = static_cast<int>(w0) * WORD_BITS;
+  freshMinY_ = y0;
+  freshMaxX_ = std::min(width() - 1, static_cast<int>(w1 + 1) * WORD_BITS - 1);
+  freshMaxY_ = y1;
+  return freshCount_;
+}
+
+void ExplorationMemory::discover(int x, int y) noexcept {
+  if (discovered_.inBounds(x, y))
+    discovered_.set(x, y);
+}
+
+std::vector<bool> ExplorationMemory::toVector() const {
+  std::vector<bool> cells(static_cast<std::size_t>(width()) *
+                          static_cast<std::size_t>(height()));
+  discovered_.forEachSet([&](int x, int y) {
+    cells[static_cast<std::size_t>(y) * static_cast<std::size_t>(width()) +
+          static_cast<std::size_t>(x)] = true;
+  });
+  return cells;
+}
+
+void ExplorationMemory::assign(const std::vector<bool> &cells) {
+  if (cells.size() != static_cast<std::size_t>(width()) *
+                          static_cast<std::size_t>(height()))
+    throw std::invalid_argument("ExplorationMemory: cell count mismatch");
+  clear();
+  std::size_t i = 0;
+  for (int y = 0; y < height(); ++y)
+    for (int x = 0; x < width(); ++x, ++i)
+      if (cells[i])
+        discovered_.set(x, y);
+}
+
+} // namespace world
@@ -0,0 +1,78 @@
+#pragma once
+#include "core/BitGrid.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace world {
+
+// Which cells of a level the player has seen, one bit per cell.
+// merge() ORs a visibility grid in a word at a time and keeps the cells
+// that were new in a second grid, so the minimap and renderer can update
+// from that delta instead of rescanning the whole level.
+class ExplorationMemory {
+public:
+  ExplorationMemory() = default;
+  ExplorationMemory(int width, int height);
+
+  int width() const noexcept { return discovered_.width(); }
+  int height() const noexcept { return discovered_.height(); }
+
+  // Forgets everything, keeps dimensions
+  void clear() noexcept;
+
+  // ORs the visible cells of the inclusive rectangle (rounded out to
+  // whole words) into memory. Returns how many cells were new; they
+  // replace the previous newly-discovered delta.
+  std::size_t merge(const core::BitGrid &visible, int x0, int y0, int x1,
+                    int y1);
+  std::size_t merge(const core::BitGrid &visible) {
+    return merge(visible, 0, 0, width() - 1, height() - 1);
+  }
+
+  // Merges the last compute() window of an FOV (any BasicFOV<View>)
+  template <typename Fov> std::size_t mergeVisible(const Fov &fov) {
+    int x0 = 0, y0 = 0, x1 = -1, y1 = -1;
+    fov.lastWindow(x0, y0, x1, y1);
+    return merge(fov.visibleBits(), x0, y0, x1, y1);
+  }
+
+  // Marks one cell (not part of the delta)
+  void discover(int x, int y) noexcept;
+
+  bool isDiscovered(int x, int y) const noexcept {
+    return discovered_.inBounds(x, y) && discovered_.test(x, y);
+  }
+  bool anyDiscoveredInRect(int x0, int y0, int x1, int y1) const noexcept {
+    return discovered_.anyInRect(x0, y0, x1, y1);
+  }
+  std::size_t count() const noexcept { return discovered_.count(); }
+
+  // Cells that the last merge() discovered, row-major
+  template <typename Fn> void forEachNewlyDiscovered(Fn &&fn) const {
+    fresh_.forEachSetInRect(freshMinX_, freshMinY_, freshMaxX_, freshMaxY_,
+                            fn);
+  }
+  std::size_t newlyDiscoveredCount() const noexcept { return freshCount_; }
+
+  const core::BitGrid &bits() const noexcept { return discovered_; }
+
+  // Row-major vector<bool> form (serialization::LevelState::discovered).
+  // assign() throws std::invalid_argument on a size mismatch.
+  std::vector<bool> toVector() const;
+  void assign(const std::vector<bool> &cells);
+
+private:
+  core::BitGrid discovered_;
+  core::BitGrid fresh_;
+  std::size_t freshCount_ = 0;
+
+  // Window holding the delta, cleared by the next merge()
+  int freshMinX_ = 0;
+  int freshMinY_ = 0;
+  int freshMaxX_ = -1;
+  int freshMaxY_ = -1;
+
+  void clearDelta() noexcept;
+};
+
+} // namespace world
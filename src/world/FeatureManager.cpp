@@ -1,13 +1,55 @@
 #include "FeatureManager.hpp"
 #include "FeatureProperties.hpp"
+#include "Map.hpp"
 
 namespace world {
 
+void FeatureManager::attach(Map *map) {
+  if (map_ && map_ != map)
+    map_->clearFeatureFlags();
+  map_ = map;
+  syncAll();
+}
+
+void FeatureManager::syncAll() {
+  ++revision_;
+  if (!map_)
+    return;
+  map_->clearFeatureFlags();
+  for (const auto &[pos, feature] : features_)
+    if (map_->inBounds(pos))
+      map_->setFeatureFlags(pos, world::blocksMovement(feature),
+                            world::blocksLineOfSight(feature));
+}
+
+void FeatureManager::refresh(core::Position pos) {
+  ++revision_;
+  if (!map_ || !map_->inBounds(pos))
+    return;
+  const Feature *feature = getFeature(pos);
+  map_->setFeatureFlags(pos, feature && world::blocksMovement(*feature),
+                        feature && world::blocksLineOfSight(*feature));
+}
+
 void FeatureManager::addFeature(core::Position pos, Feature feature) {
   features_[pos] = std::move(feature);
+  refresh(pos);
 }
 
-void FeatureManager::removeFeature(core::Position pos) { features_.erase(pos); }
+void FeatureManager::removeFeature(core::Position pos) {
+  features_.erase(pos);
+  refresh(pos);
+}
+
+bool FeatureManager::setDoorState(core::Position pos, Door::State state) {
+  Feature *feature = getFeature(pos);
+  Door *door = feature ? getDoor(*feature) : nullptr;
+  if (!door)
+    return false;
+  door->state = state;
+  refresh(pos);
+  return true;
+}
 
 bool FeatureManager::hasFeature(core::Position pos) const {
   return features_.find(pos) != features_.end();
@@ -33,7 +75,10 @@ bool FeatureManager::blocksLineOfSight(core::Position pos) const {
   return feature ? world::blocksLineOfSight(*feature) : false;
 }
 
-void FeatureManager::clear() { features_.clear(); }
+void FeatureManager::clear() {
+  features_.clear();
+  syncAll();
+}
 
 std::vector<core::Position> FeatureManager::getAllPositions() const {
   std::vector<core::Position> positions;
@@ -1,7 +1,9 @@
 #pragma once
 #include "Feature.hpp"
 #include "core/Position.hpp"
+#include <cstdint>
 #include <functional>
+#include <utility>
 #include <unordered_map>
 
 namespace core {
@@ -15,12 +17,38 @@ struct PositionHash {
 
 namespace world {
 
+class Map;
+
 // Manages features on the map
 // One feature per tile maximum
 // Features are stored by position for O(1) lookup
+// When attached to a Map, every add/remove/door change also updates the
+// map's featureBlocked / featureOpaque bit layers. The binding is not
+// copied or moved with the manager - re-attach after moving either one.
+// revision() counts changes made through the manager.
 class FeatureManager {
 public:
   FeatureManager() = default;
+  FeatureManager(const FeatureManager &other)
+      : features_(other.features_), revision_(other.revision_) {}
+  FeatureManager(FeatureManager &&other) noexcept
+      : features_(std::move(other.features_)), revision_(other.revision_) {}
+  FeatureManager &operator=(const FeatureManager &other) {
+    features_ = other.features_;
+    syncAll();
+    return *this;
+  }
+  FeatureManager &operator=(FeatureManager &&other) noexcept {
+    features_ = std::move(other.features_);
+    syncAll();
+    return *this;
+  }
+
+  // Binds to map (nullptr detaches) and rebuilds its feature layers
+  void attach(Map *map);
+  Map *attachedMap() const noexcept { return map_; }
+
+  std::uint64_t revision() const noexcept { return revision_; }
 
   // Add feature at position (replaces existing if any)
   void addFeature(core::Position pos, Feature feature);
@@ -32,9 +60,17 @@ public:
   bool hasFeature(core::Position pos) const;
 
   // Get feature at position (returns nullptr if none)
+  // Changing state through the mutable pointer bypasses the map layers -
+  // call refresh(pos) afterwards, or use setDoorState()
   Feature *getFeature(core::Position pos);
   const Feature *getFeature(core::Position pos) const;
 
+  // Opens/closes the door at pos; false if there is no door
+  bool setDoorState(core::Position pos, Door::State state);
+
+  // Re-derives the map layer bits of one position
+  void refresh(core::Position pos);
+
   // Property queries (convenience wrappers)
   bool blocksMovement(core::Position pos) const;
   bool blocksLineOfSight(core::Position pos) const;
@@ -49,7 +85,11 @@ public:
   std::size_t size() const;
 
 private:
+  void syncAll();
+
   std::unordered_map<core::Position, Feature, core::PositionHash> features_;
+  Map *map_ = nullptr;
+  std::uint64_t revision_ = 0;
 };
 
 } // namespace world
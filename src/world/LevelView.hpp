@@ -0,0 +1,43 @@
+#pragma once
+#include "FeatureManager.hpp"
+#include "Map.hpp"
+#include <cassert>
+#include <cstdint>
+
+namespace world {
+
+// Map plus its FeatureManager as one core::MovementView: closed doors
+// block sight and movement, so FOV stops at them and A* only returns
+// paths a MoveAction can walk. Reads the map's combined bit layers -
+// features must be attached to the map (FeatureManager::attach), there
+// is no per-cell feature lookup.
+class LevelView {
+public:
+  LevelView(const Map &map, const FeatureManager &features) : map_(map) {
+    assert(features.attachedMap() == &map);
+    (void)features;
+  }
+
+  int width() const noexcept { return map_.width(); }
+  int height() const noexcept { return map_.height(); }
+  bool blocksLineOfSight(int x, int y) const noexcept {
+    return map_.blocksSight(x, y);
+  }
+  bool blocksMovement(int x, int y) const noexcept {
+    return !map_.isPassable(x, y);
+  }
+  std::uint64_t sightRevision() const noexcept {
+    return map_.sightRevision();
+  }
+  bool sightChangedSince(std::uint64_t revision, int x0, int y0, int x1,
+                         int y1) const noexcept {
+    return map_.sightChangedSince(revision, x0, y0, x1, y1);
+  }
+
+  const Map &map() const noexcept { return map_; }
+
+private:
+  const Map &map_;
+};
+
+} // namespace world
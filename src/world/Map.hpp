@@ -1,19 +1,52 @@
 #pragma once
 #include "Tile.hpp"
 #include "TileProperties.hpp"
+#include "core/BitGrid.hpp"
+#include "core/EditLog.hpp"
 #include "core/Position.hpp"
 #include <cassert>
 #include <cstddef>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace world {
 
+// Tile grid plus derived one-bit-per-cell layers, kept in sync on every
+// write so hot loops (FOV, A*, generators) test a bit instead of looking
+// tile properties up:
+// - opaque / walkable: from the tile, updated by set() and fill()
+// - featureBlocked / featureOpaque: from features, maintained by an
+//   attached FeatureManager (closed doors)
+// Layers are core::BitGrids, so whole rows are available as word spans.
+// Cells whose sight blocking (tile or feature) changes are recorded in a
+// core::EditLog, so FOVs can tell whether their window is still valid.
 class Map {
 public:
   Map(int w, int h, Tile fill = Tile::SolidRock)
       : w_(w), h_(h),
-        data_(static_cast<std::size_t>(w) * static_cast<std::size_t>(h), fill) {
+        data_(static_cast<std::size_t>(w) * static_cast<std::size_t>(h), fill),
+        opaque_(w, h), walkable_(w, h), featureBlocked_(w, h),
+        featureOpaque_(w, h) {
     assert(w_ > 0 && h_ > 0);
+    fillLayers(fill);
+  }
+
+  // Adopts a row-major buffer of w * h tiles (loaders fill one buffer
+  // instead of constructing a map and calling set() per cell)
+  Map(int w, int h, std::vector<Tile> tiles)
+      : w_(w), h_(h), data_(std::move(tiles)), opaque_(w, h), walkable_(w, h),
+        featureBlocked_(w, h), featureOpaque_(w, h) {
+    assert(w_ > 0 && h_ > 0);
+    assert(data_.size() ==
+           static_cast<std::size_t>(w) * static_cast<std::size_t>(h));
+    for (int y = 0; y < h_; ++y) {
+      for (int x = 0; x < w_; ++x) {
+        const std::uint8_t flags = tileFlags(data_[idx({x, y})]);
+        opaque_.assign(x, y, flags & TILE_BLOCKS_LOS);
+        walkable_.assign(x, y, !(flags & TILE_BLOCKS_MOVE));
+      }
+    }
   }
 
   int width() const noexcept { return w_; }
@@ -32,32 +65,118 @@ public:
     return data_[idx(p)];
   }
 
+  // Row-major tile array (save snapshots copy it in one go)
+  std::span<const Tile> tiles() const noexcept { return data_; }
+
   void set(core::Position p, Tile t) noexcept {
     assert(inBounds(p));
-    data_[idx(p)] = t;
+    Tile &cell = data_[idx(p)];
+    if (cell != t) {
+      cell = t;
+      ++tileRevision_;
+    }
+    const std::uint8_t flags = tileFlags(t);
+    const bool opaque = flags & TILE_BLOCKS_LOS;
+    if (opaque != opaque_.test(p.x, p.y)) {
+      opaque_.assign(p.x, p.y, opaque);
+      sightLog_.record(p.x, p.y);
+    }
+    walkable_.assign(p.x, p.y, !(flags & TILE_BLOCKS_MOVE));
   }
 
   void fill(Tile t) noexcept {
-    for (int y = 0; y < height(); ++y)
-      for (int x = 0; x < width(); ++x)
-        set({x, y}, t);
+    for (Tile &cell : data_)
+      cell = t;
+    fillLayers(t);
+    sightLog_.recordAll();
+    ++tileRevision_;
   }
 
+  // Tile opacity (out of bounds counts as opaque)
   inline bool isOpaque(int x, int y) const noexcept {
     if (x < 0 || x >= w_ || y < 0 || y >= h_) {
       return true; // poza mapą traktujemy jako blokadę
     }
-    return world::blocksLineOfSight(data_[idx({x, y})]);
+    return opaque_.test(x, y);
+  }
+
+  // Tile walkability (out of bounds is not walkable)
+  bool isWalkable(int x, int y) const noexcept {
+    return inBounds(x, y) && walkable_.test(x, y);
   }
 
   bool blocksMovement(core::Position p) const noexcept {
     if (!inBounds(p))
       return true;
-    return world::blocksMovement(at(p));
+    return !walkable_.test(p.x, p.y);
   }
 
   inline bool blocksLineOfSight(core::Position p) const noexcept {
-    return world::blocksLineOfSight(at(p));
+    assert(inBounds(p));
+    return opaque_.test(p.x, p.y);
+  }
+  // core::MapView form, lets BasicFOV<Map> / BasicPathfinding<Map> read
+  // the opacity layer directly
+  bool blocksLineOfSight(int x, int y) const noexcept {
+    return opaque_.test(x, y);
+  }
+
+  // Tile and feature layers combined: walkable tile without a blocking
+  // feature / opaque tile or opaque feature
+  bool isPassable(int x, int y) const noexcept {
+    return isWalkable(x, y) && !featureBlocked_.test(x, y);
+  }
+  bool blocksSight(int x, int y) const noexcept {
+    return isOpaque(x, y) || featureOpaque_.test(x, y);
+  }
+
+  // Feature layers, written by FeatureManager
+  void setFeatureFlags(core::Position p, bool blocksMove,
+                       bool blocksSight) noexcept {
+    assert(inBounds(p));
+    featureBlocked_.assign(p.x, p.y, blocksMove);
+    if (blocksSight != featureOpaque_.test(p.x, p.y)) {
+      featureOpaque_.assign(p.x, p.y, blocksSight);
+      sightLog_.record(p.x, p.y);
+    }
+  }
+  void clearFeatureFlags() noexcept {
+    featureBlocked_.fill(false);
+    featureOpaque_.fill(false);
+    sightLog_.recordAll();
+  }
+
+  // Recomputes tile layers, needed only after TileRegistry overrides
+  // change properties of tiles already on the map
+  void refreshTileLayers() noexcept {
+    for (int y = 0; y < h_; ++y)
+      for (int x = 0; x < w_; ++x)
+        set({x, y}, data_[idx({x, y})]);
+    sightLog_.recordAll();
+  }
+
+  // Bumps whenever a tile actually changes (save journals skip the tile
+  // diff while it stays put)
+  std::uint64_t tileRevision() const noexcept { return tileRevision_; }
+
+  // Sight change tracking (core::SightTrackingView): the revision bumps
+  // on every edit that may change blocksSight() of a cell
+  std::uint64_t sightRevision() const noexcept {
+    return sightLog_.revision();
+  }
+  bool sightChangedSince(std::uint64_t revision, int x0, int y0, int x1,
+                         int y1) const noexcept {
+    return sightLog_.changedSince(revision, x0, y0, x1, y1);
+  }
+
+  // Bit layers for word-level processing (row(y) gives a span of words)
+  const core::BitGrid &opaqueBits() const noexcept { return opaque_; }
+  const core::BitGrid &walkableBits() const noexcept { return walkable_; }
+  const core::BitGrid &featureBlockedBits() const noexcept {
+    return featureBlocked_;
+  }
+  const core::BitGrid &featureOpaqueBits() const noexcept {
+    return featureOpaque_;
   }
 
 private:
@@ -67,9 +186,21 @@ private:
            static_cast<std::size_t>(p.x);
   }
 
+  void fillLayers(Tile t) noexcept {
+    const std::uint8_t flags = tileFlags(t);
+    opaque_.fill(flags & TILE_BLOCKS_LOS);
+    walkable_.fill(!(flags & TILE_BLOCKS_MOVE));
+  }
+
   int w_;
   int h_;
   std::vector<Tile> data_;
+  core::BitGrid opaque_;
+  core::BitGrid walkable_;
+  core::BitGrid featureBlocked_;
+  core::BitGrid featureOpaque_;
+  core::EditLog sightLog_;
+  std::uint64_t tileRevision_ = 0;
 };
 
 } // namespace world
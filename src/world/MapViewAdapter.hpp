@@ -2,6 +2,9 @@
 #include "Map.hpp"
 #include "core/IMapView.hpp"
 namespace world {
+// Virtual view of a Map for IMapView users (player FOV, chase maps).
+// Reads the combined tile + feature layers, so closed doors block once a
+// FeatureManager is attached to the map.
 class MapViewAdapter final : public core::IMapView {
   const Map &m_;
 
@@ -10,7 +13,14 @@ public:
   int width() const noexcept override { return m_.width(); }
   int height() const noexcept override { return m_.height(); }
   bool blocksLineOfSight(int x, int y) const noexcept override {
-    return m_.blocksLineOfSight({x, y});
+    return m_.blocksSight(x, y);
+  }
+  std::uint64_t sightRevision() const noexcept override {
+    return m_.sightRevision();
+  }
+  bool sightChangedSince(std::uint64_t revision, int x0, int y0, int x1,
+                         int y1) const noexcept override {
+    return m_.sightChangedSince(revision, x0, y0, x1, y1);
   }
 };
 } // namespace world
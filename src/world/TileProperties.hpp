@@ -1,6 +1,9 @@
 #pragma once
 #include "Tile.hpp"
 #include "TileEnum.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
 
 namespace world {
 
@@ -12,26 +15,58 @@ struct TileProperties {
   int damage_per_turn;  // Damage dealt each turn while standing on tile
 
   // Default constructor for safe initialization
-  TileProperties()
+  constexpr TileProperties()
       : movement_cost(-1), blocks_los(true), damage_immediate(0),
         damage_per_turn(0) {}
 
   // Parameterized constructor
-  TileProperties(int move_cost, bool blocks, int dmg_imm, int dmg_turn)
+  constexpr TileProperties(int move_cost, bool blocks, int dmg_imm,
+                           int dmg_turn)
       : movement_cost(move_cost), blocks_los(blocks), damage_immediate(dmg_imm),
         damage_per_turn(dmg_turn) {}
 };
 
+// Per-tile flag bits, derived from TileProperties whenever a tile is
+// registered, so hot loops test one byte instead of comparing fields
+inline constexpr std::uint8_t TILE_BLOCKS_MOVE = 1u << 0; // movement_cost < 0
+inline constexpr std::uint8_t TILE_BLOCKS_LOS = 1u << 1;  // blocks_los
+inline constexpr std::uint8_t TILE_DAMAGING = 1u << 2;    // any damage > 0
+
+constexpr std::uint8_t tileFlagsOf(const TileProperties &p) noexcept {
+  return static_cast<std::uint8_t>(
+      (p.movement_cost < 0 ? TILE_BLOCKS_MOVE : 0) |
+      (p.blocks_los ? TILE_BLOCKS_LOS : 0) |
+      (p.damage_immediate > 0 || p.damage_per_turn > 0 ? TILE_DAMAGING : 0));
+}
+
+namespace detail {
+// Dense table indexed by Tile, one cache line for all properties.
+// Constant-initialized with the defaults (no first-use guard on lookup);
+// written only by TileRegistry, so configure tiles before starting
+// worker threads.
+struct alignas(64) TileTable {
+  std::array<TileProperties, TILE_COUNT> props;
+  std::array<std::uint8_t, TILE_COUNT> flags;
+};
+extern TileTable tileTable;
+} // namespace detail
+
 // Convenience wrapper function for accessing tile properties
-// Internally queries TileRegistry singleton
-const TileProperties &getProperties(Tile t);
+// Array lookup in the table maintained by TileRegistry
+inline const TileProperties &getProperties(Tile t) noexcept {
+  return detail::tileTable.props[static_cast<std::size_t>(t)];
+}
 
-// Helper functions for common property queries
-inline bool blocksMovement(Tile t) {
-  return getProperties(t).movement_cost < 0;
+inline std::uint8_t tileFlags(Tile t) noexcept {
+  return detail::tileTable.flags[static_cast<std::size_t>(t)];
 }
 
-inline bool blocksLineOfSight(Tile t) { return getProperties(t).blocks_los; }
+// Helper functions for common property queries
+inline bool blocksMovement(Tile t) { return tileFlags(t) & TILE_BLOCKS_MOVE; }
+
+inline bool blocksLineOfSight(Tile t) { return tileFlags(t) & TILE_BLOCKS_LOS; }
+
+inline bool isDamaging(Tile t) { return tileFlags(t) & TILE_DAMAGING; }
 
 inline int getMovementCost(Tile t) { return getProperties(t).movement_cost; }
 
@@ -6,67 +6,95 @@
 
 namespace world {
 
-TileRegistry::TileRegistry() { initDefaults(); }
+namespace {
 
-TileRegistry &TileRegistry::instance() {
-  static TileRegistry instance;
-  return instance;
+constexpr void setEntry(detail::TileTable &table, Tile t,
+                        const TileProperties &props) {
+  const auto i = static_cast<std::size_t>(t);
+  table.props[i] = props;
+  table.flags[i] = tileFlagsOf(props);
 }
 
-void TileRegistry::initDefaults() {
-  // Minimal safe defaults for all defined tile types
+// Minimal safe defaults for all defined tile types
+constexpr detail::TileTable makeDefaultTable() {
+  detail::TileTable table{};
 
   // OpenGround: walkable, visible, no damage
-  registerTile(Tile::OpenGround,
-               TileProperties{
-                   100,   // movement_cost: normal speed
-                   false, // blocks_los: does not block vision
-                   0,     // damage_immediate: no damage on entry
-                   0      // damage_per_turn: no damage while standing
-               });
+  setEntry(table, Tile::OpenGround,
+           TileProperties{
+               100,   // movement_cost: normal speed
+               false, // blocks_los: does not block vision
+               0,     // damage_immediate: no damage on entry
+               0      // damage_per_turn: no damage while standing
+           });
 
   // SolidRock: impassable, blocks vision, no damage
-  registerTile(Tile::SolidRock, TileProperties{
-                                    -1,   // movement_cost: impassable
-                                    true, // blocks_los: blocks vision
-                                    0,    // damage_immediate: no damage
-                                    0     // damage_per_turn: no damage
-                                });
+  setEntry(table, Tile::SolidRock,
+           TileProperties{
+               -1,   // movement_cost: impassable
+               true, // blocks_los: blocks vision
+               0,    // damage_immediate: no damage
+               0     // damage_per_turn: no damage
+           });
 
   // ShallowLiquid: slow movement, visible, no damage (predefined)
-  registerTile(Tile::ShallowLiquid,
-               TileProperties{
-                   200,   // movement_cost: half speed
-                   false, // blocks_los: does not block vision
-                   0,     // damage_immediate: no damage
-                   0      // damage_per_turn: no damage
-               });
+  setEntry(table, Tile::ShallowLiquid,
+           TileProperties{
+               200,   // movement_cost: half speed
+               false, // blocks_los: does not block vision
+               0,     // damage_immediate: no damage
+               0      // damage_per_turn: no damage
+           });
 
   // DeepLiquid: impassable, visible, no damage (predefined)
-  registerTile(Tile::DeepLiquid,
-               TileProperties{
-                   -1,    // movement_cost: impassable (need swimming)
-                   false, // blocks_los: does not block vision
-                   0,     // damage_immediate: no damage
-                   0      // damage_per_turn: no damage
-               });
+  setEntry(table, Tile::DeepLiquid,
+           TileProperties{
+               -1,    // movement_cost: impassable (need swimming)
+               false, // blocks_los: does not block vision
+               0,     // damage_immediate: no damage
+               0      // damage_per_turn: no damage
+           });
+
+  return table;
+}
+
+} // namespace
+
+namespace detail {
+constinit TileTable tileTable = makeDefaultTable();
+} // namespace detail
+
+TileRegistry::TileRegistry() { initDefaults(); }
+
+TileRegistry &TileRegistry::instance() {
+  static TileRegistry instance;
+  return instance;
+}
+
+void TileRegistry::initDefaults() {
+  detail::tileTable = makeDefaultTable();
+  registered_.fill(true);
 }
 
 void TileRegistry::registerTile(Tile t, const TileProperties &props) {
-  properties_[t] = props;
+  const auto i = static_cast<std::size_t>(t);
+  if (i >= TILE_COUNT)
+    throw std::out_of_range("TileRegistry: tile type out of range");
+  setEntry(detail::tileTable, t, props);
+  registered_[i] = true;
 }
 
 const TileProperties &TileRegistry::getProperties(Tile t) const {
-  auto it = properties_.find(t);
-  if (it == properties_.end()) {
+  if (!hasProperties(t)) {
     throw std::runtime_error(
         "TileRegistry: No properties registered for tile type");
   }
-  return it->second;
+  return world::getProperties(t);
 }
 
 bool TileRegistry::hasProperties(Tile t) const {
-  return properties_.find(t) != properties_.end();
+  const auto i = static_cast<std::size_t>(t);
+  return i < TILE_COUNT && registered_[i];
 }
 
 void TileRegistry::loadFromJSON(const std::string &path) {
@@ -117,9 +145,4 @@ void TileRegistry::loadFromJSON(const std::string &path) {
   }
 }
 
-// Implementation of wrapper function
-const TileProperties &getProperties(Tile t) {
-  return TileRegistry::instance().getProperties(t);
-}
-
 } // namespace world
@@ -2,13 +2,15 @@
 #include "Tile.hpp"
 #include "TileEnum.hpp"
 #include "TileProperties.hpp"
-#include <map>
+#include <array>
 #include <string>
 
 namespace world {
 
 // Singleton registry managing tile properties
 // Loads from JSON config with hardcoded fallback defaults
+// Owns no storage of its own: every registration rewrites the dense
+// table behind world::getProperties() / tileFlags()
 class TileRegistry {
 public:
   // Singleton access
@@ -41,8 +43,7 @@ private:
   // Initialize hardcoded fallback defaults
   void initDefaults();
 
-  // Storage: ordered map (O(log n) lookup, acceptable for small tile count)
-  std::map<Tile, TileProperties> properties_;
+  std::array<bool, TILE_COUNT> registered_{};
 };
 
 } // namespace world
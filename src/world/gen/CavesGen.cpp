@@ -1,177 +1,236 @@
 #include "CavesGen.hpp"
 #include "config/DungeonConfig.hpp"
 #include <algorithm>
-#include <climits>
-#include <queue>
+#include <cstdint>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace { // ---------- file-scope helpers (caves) ----------
 
-using CompId = size_t;
-constexpr CompId Invalid = static_cast<CompId>(-1);
+using Word = core::BitGrid::Word;
+constexpr int WORD_BITS = core::BitGrid::WORD_BITS;
 
-int countWallNeighbors8(const world::Map &m, int x, int y) {
-  int c = 0;
-  for (int yy = y - 1; yy <= y + 1; ++yy)
-    for (int xx = x - 1; xx <= x + 1; ++xx) {
-      if (xx == x && yy == y)
-        continue;
-      if (!m.inBounds(xx, yy) || world::blocksMovement(m.at({xx, yy})))
-        ++c;
-    }
-  return c;
+// Adds one-bit-per-cell input to a 4-bit bit-sliced counter (c[0] = LSB)
+inline void addPlane(Word c[4], Word in) noexcept {
+  for (int b = 0; b < 4 && in; ++b) {
+    const Word carry = c[b] & in;
+    c[b] ^= in;
+    in = carry;
+  }
 }
 
-// One CA iteration with birth/survive thresholds.
-void caStep(world::Map &m, int birth, int survive) {
-  world::Map next(m.width(), m.height(), world::Tile::SolidRock);
-  for (int y = 0; y < m.height(); ++y)
-    for (int x = 0; x < m.width(); ++x) {
-      const bool edge =
-          (x == 0 || y == 0 || x == m.width() - 1 || y == m.height() - 1);
-      if (edge) {
-        next.set({x, y}, world::Tile::SolidRock);
-        continue;
-      }
-      const int wn = countWallNeighbors8(m, x, y);
-      const bool wall_next =
-          world::blocksMovement(m.at({x, y})) ? (wn >= survive) : (wn >= birth);
-      next.set({x, y},
-               wall_next ? world::Tile::SolidRock : world::Tile::OpenGround);
-    }
-  // copy back
-  for (int y = 0; y < m.height(); ++y)
-    for (int x = 0; x < m.width(); ++x)
-      m.set({x, y}, next.at({x, y}));
+// Cells whose bit-sliced count is >= t (t constant for the whole grid)
+inline Word atLeast(const Word c[4], int t) noexcept {
+  if (t <= 0)
+    return ~Word{0};
+  if (t > 8)
+    return 0;
+  Word gt = 0;
+  Word eq = ~Word{0};
+  for (int b = 3; b >= 0; --b) {
+    const Word tb = ((t >> b) & 1) ? ~Word{0} : Word{0};
+    gt |= eq & c[b] & ~tb;
+    eq &= ~(c[b] ^ tb);
+  }
+  return gt | eq;
 }
 
-// Label 4-neighbour floor components; returns count. `lbl` sized to W*H.
-size_t labelComponents(const world::Map &m, std::vector<CompId> &lbl) {
-  const int W = m.width(), H = m.height();
-  lbl.assign(static_cast<size_t>(W) * static_cast<size_t>(H), Invalid);
-  auto id = [&](int x, int y) {
-    return static_cast<size_t>(y) * static_cast<size_t>(W) +
-           static_cast<size_t>(x);
-  };
-
-  size_t comps = 0;
-  std::queue<core::Position> q;
-  for (int y = 0; y < H; ++y)
-    for (int x = 0; x < W; ++x) {
-      const auto k = id(x, y);
-      if (world::getProperties(m.at({x, y})).movement_cost < 0 ||
-          lbl[k] != Invalid)
-        continue;
+// Row neighbours of every cell in word w: bit i of west() is cell x - 1,
+// bit i of east() is cell x + 1 (carried across word boundaries)
+inline Word west(std::span<const Word> row, std::size_t w) noexcept {
+  return (row[w] << 1) | (w > 0 ? row[w - 1] >> (WORD_BITS - 1) : 0);
+}
+inline Word east(std::span<const Word> row, std::size_t w) noexcept {
+  return (row[w] >> 1) |
+         (w + 1 < row.size() ? row[w + 1] << (WORD_BITS - 1) : 0);
+}
 
-      lbl[k] = comps;
-      q.push({x, y});
-      while (!q.empty()) {
-        auto p = q.front();
-        q.pop();
-        static const int dx[4] = {1, -1, 0, 0}, dy[4] = {0, 0, 1, -1};
-        for (int i = 0; i < 4; ++i) {
-          const int nx = p.x + dx[i], ny = p.y + dy[i];
-          if (!m.inBounds(nx, ny))
-            continue;
-          const auto kk = id(nx, ny);
-          if (world::getProperties(m.at({nx, ny})).movement_cost < 0 ||
-              lbl[kk] != Invalid)
-            continue;
-          lbl[kk] = comps;
-          q.push({nx, ny});
-        }
+// Floor connectivity as a disjoint-set forest over cell ids (y * W + x).
+// Labeling is one row-major pass (union with west and north floor
+// neighbours); carving a cell unions it with its floor neighbours, so
+// components merge incrementally instead of being relabeled.
+class FloorComponents {
+public:
+  explicit FloorComponents(const world::Map &m)
+      : W_(m.width()), H_(m.height()),
+        parent_(static_cast<size_t>(W_) * static_cast<size_t>(H_)),
+        size_(parent_.size(), 1), floor_(parent_.size(), 0) {
+    for (int y = 0; y < H_; ++y)
+      for (int x = 0; x < W_; ++x) {
+        const std::uint32_t k = id(x, y);
+        parent_[k] = k;
+        if (!m.isWalkable(x, y))
+          continue;
+        floor_[k] = 1;
+        if (x > 0 && floor_[k - 1])
+          unite(k, k - 1);
+        if (y > 0 && floor_[k - static_cast<std::uint32_t>(W_)])
+          unite(k, k - static_cast<std::uint32_t>(W_));
       }
-      ++comps;
+  }
+
+  std::uint32_t id(int x, int y) const noexcept {
+    return static_cast<std::uint32_t>(y) * static_cast<std::uint32_t>(W_) +
+           static_cast<std::uint32_t>(x);
+  }
+  size_t cellCount() const noexcept { return parent_.size(); }
+  bool isFloor(std::uint32_t k) const noexcept { return floor_[k] != 0; }
+  std::uint32_t componentSize(std::uint32_t k) noexcept { return size_[find(k)]; }
+
+  std::uint32_t find(std::uint32_t k) noexcept {
+    while (parent_[k] != k) {
+      parent_[k] = parent_[parent_[k]]; // path halving
+      k = parent_[k];
     }
-  return comps;
-}
+    return k;
+  }
+
+  void unite(std::uint32_t a, std::uint32_t b) noexcept {
+    a = find(a);
+    b = find(b);
+    if (a == b)
+      return;
+    if (size_[a] < size_[b])
+      std::swap(a, b);
+    parent_[b] = a;
+    size_[a] += size_[b];
+  }
+
+  // Marks a freshly carved cell as floor and merges it with its neighbours
+  void addFloor(int x, int y) noexcept {
+    const std::uint32_t k = id(x, y);
+    if (floor_[k])
+      return;
+    floor_[k] = 1;
+    static constexpr int dx[4] = {1, -1, 0, 0}, dy[4] = {0, 0, 1, -1};
+    for (int i = 0; i < 4; ++i) {
+      const int nx = x + dx[i], ny = y + dy[i];
+      if (nx >= 0 && ny >= 0 && nx < W_ && ny < H_ && floor_[id(nx, ny)])
+        unite(k, id(nx, ny));
+    }
+  }
+
+private:
+  int W_;
+  int H_;
+  std::vector<std::uint32_t> parent_;
+  std::vector<std::uint32_t> size_;
+  std::vector<std::uint8_t> floor_;
+};
 
 // Simple L corridor through walls between two points.
-void carveLCorridorThroughWalls(world::Map &m, core::Position a,
-                                core::Position b) {
+void carveLCorridorThroughWalls(world::Map &m, FloorComponents &comps,
+                                core::Position a, core::Position b) {
+  auto carve = [&](int x, int y) {
+    m.set({x, y}, world::Tile::OpenGround);
+    comps.addFloor(x, y);
+  };
   if (a.x == b.x && a.y == b.y)
     return;
   if (a.x <= b.x) {
     for (int x = std::min(a.x, b.x); x <= std::max(a.x, b.x); ++x)
-      m.set({x, a.y}, world::Tile::OpenGround);
+      carve(x, a.y);
     for (int y = std::min(a.y, b.y); y <= std::max(a.y, b.y); ++y)
-      m.set({b.x, y}, world::Tile::OpenGround);
+      carve(b.x, y);
   } else {
     for (int y = std::min(a.y, b.y); y <= std::max(a.y, b.y); ++y)
-      m.set({a.x, y}, world::Tile::OpenGround);
+      carve(a.x, y);
     for (int x = std::min(a.x, b.x); x <= std::max(a.x, b.x); ++x)
-      m.set({x, b.y}, world::Tile::OpenGround);
+      carve(x, b.y);
   }
 }
 
-// Connect every component to the largest one by shortest (Manhattan) L tunnels.
+// Connect every component to the largest one by shortest (Manhattan) L
+// tunnels. One multi-source BFS from the main component gives every cell
+// its nearest main cell; each other component attaches at its closest
+// cell. O(W*H) overall instead of a pairwise search per component.
 void connectComponentsToMain(world::Map &m) {
   const int W = m.width(), H = m.height();
-  auto id = [&](int x, int y) {
-    return static_cast<size_t>(y) * static_cast<size_t>(W) +
-           static_cast<size_t>(x);
-  };
+  FloorComponents comps(m);
+  const size_t N = comps.cellCount();
 
-  std::vector<CompId> lbl;
-  size_t comps = labelComponents(m, lbl);
-  if (comps <= 1)
+  // Main component: largest, first in row-major order on ties.
+  std::uint32_t mainRoot = UINT32_MAX;
+  std::uint32_t mainSize = 0;
+  std::uint32_t floorCount = 0;
+  for (std::uint32_t k = 0; k < N; ++k) {
+    if (!comps.isFloor(k))
+      continue;
+    ++floorCount;
+    if (comps.componentSize(k) > mainSize) {
+      mainRoot = comps.find(k);
+      mainSize = comps.componentSize(k);
+    }
+  }
+  if (mainSize == floorCount)
     return;
 
-  // Find main component by size.
-  std::vector<size_t> comp_size(comps, 0);
-  for (size_t k = 0; k < lbl.size(); ++k)
-    if (lbl[k] != Invalid)
-      ++comp_size[lbl[k]];
-  size_t main_id = 0;
-  for (size_t i = 1; i < comp_size.size(); ++i)
-    if (comp_size[i] > comp_size[main_id])
-      main_id = i;
-
-  // Collect cells of each component.
-  std::vector<std::vector<core::Position>> cells(comps);
-  for (int y = 0; y < H; ++y)
-    for (int x = 0; x < W; ++x) {
-      const CompId c = lbl[id(x, y)];
-      if (c != Invalid)
-        cells[c].push_back({x, y});
+  // BFS over the whole rectangle: 4-neighbour distance == Manhattan.
+  std::vector<int> dist(N, -1);
+  std::vector<std::uint32_t> nearest(N);
+  std::vector<std::uint32_t> queue;
+  queue.reserve(N);
+  for (std::uint32_t k = 0; k < N; ++k)
+    if (comps.isFloor(k) && comps.find(k) == mainRoot) {
+      dist[k] = 0;
+      nearest[k] = k;
+      queue.push_back(k);
+    }
+  for (size_t head = 0; head < queue.size(); ++head) {
+    const std::uint32_t k = queue[head];
+    const int x = static_cast<int>(k % static_cast<std::uint32_t>(W));
+    const int y = static_cast<int>(k / static_cast<std::uint32_t>(W));
+    static constexpr int dx[4] = {1, -1, 0, 0}, dy[4] = {0, 0, 1, -1};
+    for (int i = 0; i < 4; ++i) {
+      const int nx = x + dx[i], ny = y + dy[i];
+      if (nx < 0 || ny < 0 || nx >= W || ny >= H)
+        continue;
+      const std::uint32_t kk = comps.id(nx, ny);
+      if (dist[kk] >= 0)
+        continue;
+      dist[kk] = dist[k] + 1;
+      nearest[kk] = nearest[k];
+      queue.push_back(kk);
     }
+  }
 
-  // Connect non-main to main via closest pair.
-  for (size_t c = 0; c < comps; ++c) {
-    if (c == main_id || cells[c].empty())
+  // Closest cell of every other component (first in row-major on ties).
+  struct Attachment {
+    int dist;
+    std::uint32_t cell;
+  };
+  std::vector<std::uint32_t> bestOf(N, UINT32_MAX); // root -> cell
+  std::vector<Attachment> attachments;
+  for (std::uint32_t k = 0; k < N; ++k) {
+    if (!comps.isFloor(k))
+      continue;
+    const std::uint32_t r = comps.find(k);
+    if (r == mainRoot)
       continue;
+    if (bestOf[r] == UINT32_MAX) {
+      bestOf[r] = static_cast<std::uint32_t>(attachments.size());
+      attachments.push_back({dist[k], k});
+    } else if (dist[k] < attachments[bestOf[r]].dist) {
+      attachments[bestOf[r]] = {dist[k], k};
+    }
+  }
 
-    int bestD = INT_MAX;
-    core::Position A{}, B{};
-    for (const auto &p : cells[c])
-      for (const auto &q : cells[main_id]) {
-        int d = std::abs(p.x - q.x) + std::abs(p.y - q.y);
-        if (d < bestD) {
-          bestD = d;
-          A = p;
-          B = q;
-        }
-      }
-    carveLCorridorThroughWalls(m, A, B);
-
-    // Relabel after connecting (simple and robust).
-    comps = labelComponents(m, lbl);
-    comp_size.assign(comps, 0);
-    for (size_t k = 0; k < lbl.size(); ++k)
-      if (lbl[k] != Invalid)
-        ++comp_size[lbl[k]];
-    main_id = 0;
-    for (size_t i = 1; i < comp_size.size(); ++i)
-      if (comp_size[i] > comp_size[main_id])
-        main_id = i;
-
-    cells.assign(comps, {});
-    for (int y = 0; y < H; ++y)
-      for (int x = 0; x < W; ++x) {
-        CompId c2 = lbl[id(x, y)];
-        if (c2 != Invalid)
-          cells[c2].push_back({x, y});
-      }
+  // Shortest tunnels first: a tunnel crossing another component merges it,
+  // which then needs no tunnel of its own.
+  std::stable_sort(attachments.begin(), attachments.end(),
+                   [](const Attachment &a, const Attachment &b) {
+                     return a.dist < b.dist;
+                   });
+  for (const Attachment &att : attachments) {
+    if (comps.find(att.cell) == comps.find(mainRoot))
+      continue;
+    const std::uint32_t to = nearest[att.cell];
+    const auto uw = static_cast<std::uint32_t>(W);
+    carveLCorridorThroughWalls(
+        m, comps,
+        {static_cast<int>(att.cell % uw), static_cast<int>(att.cell / uw)},
+        {static_cast<int>(to % uw), static_cast<int>(to / uw)});
   }
 }
 
@@ -179,29 +238,76 @@ void connectComponentsToMain(world::Map &m) {
 
 namespace world {
 
+void cellularStep(const core::BitGrid &cur, core::BitGrid &next, int birth,
+                  int survive) {
+  const int W = cur.width();
+  const int H = cur.height();
+  const std::size_t words = cur.wordsPerRow();
+  if (words == 0)
+    return;
+
+  // Border columns forced to wall, padding past width kept clear
+  const unsigned used = static_cast<unsigned>(W) % WORD_BITS;
+  const Word tail = used == 0 ? ~Word{0} : (Word{1} << used) - 1;
+  const std::size_t lastWord = words - 1;
+  const Word lastBit = Word{1} << ((W - 1) % WORD_BITS);
+
+  for (int y = 0; y < H; ++y) {
+    std::span<Word> out = next.row(y);
+    if (y == 0 || y == H - 1) {
+      for (std::size_t w = 0; w < words; ++w)
+        out[w] = ~Word{0};
+      out[lastWord] &= tail;
+      continue;
+    }
+
+    std::span<const Word> up = cur.row(y - 1);
+    std::span<const Word> mid = cur.row(y);
+    std::span<const Word> down = cur.row(y + 1);
+    for (std::size_t w = 0; w < words; ++w) {
+      Word c[4] = {0, 0, 0, 0};
+      addPlane(c, west(up, w));
+      addPlane(c, up[w]);
+      addPlane(c, east(up, w));
+      addPlane(c, west(mid, w));
+      addPlane(c, east(mid, w));
+      addPlane(c, west(down, w));
+      addPlane(c, down[w]);
+      addPlane(c, east(down, w));
+
+      const Word wall = mid[w];
+      out[w] = (wall & atLeast(c, survive)) | (~wall & atLeast(c, birth));
+    }
+    out[0] |= Word{1};
+    out[lastWord] = (out[lastWord] | lastBit) & tail;
+  }
+}
+
 void generateCavesModuleImpl(Map &m, const CavesOptions &opt,
                              const ::config::CaveGenerationConfig &caveGen,
-                             std::mt19937 &G) {
-
-  m.fill(Tile::SolidRock);
-
-  // Seed phase (random interior, solid border).
-  std::uniform_int_distribution<int> pct(caveGen.random_percent_min,
-                                         caveGen.random_percent_max);
-  for (int y = 0; y < m.height(); ++y)
-    for (int x = 0; x < m.width(); ++x) {
-      const bool edge =
-          (x == 0 || y == 0 || x == m.width() - 1 || y == m.height() - 1);
-      if (edge)
-        m.set({x, y}, Tile::SolidRock);
-      else
-        m.set({x, y},
-              (pct(G) < opt.fill_percent) ? Tile::SolidRock : Tile::OpenGround);
-    }
+                             core::Rng &G) {
+  const int W = m.width();
+  const int H = m.height();
+
+  // Seed phase (random interior, solid border) straight into the bitmap.
+  core::BitGrid cur(W, H, true);
+  for (int y = 1; y < H - 1; ++y)
+    for (int x = 1; x < W - 1; ++x)
+      if (G.uniformInt(caveGen.random_percent_min,
+                       caveGen.random_percent_max) >= opt.fill_percent)
+        cur.reset(x, y);
 
-  // CA smoothing passes.
-  for (int s = 0; s < opt.steps; ++s)
-    caStep(m, opt.birth, opt.survive);
+  // CA smoothing passes, ping-pong between two preallocated buffers.
+  core::BitGrid next(W, H);
+  for (int s = 0; s < opt.steps; ++s) {
+    cellularStep(cur, next, opt.birth, opt.survive);
+    std::swap(cur, next);
+  }
+
+  // Single write-back to tiles.
+  for (int y = 0; y < H; ++y)
+    for (int x = 0; x < W; ++x)
+      m.set({x, y}, cur.test(x, y) ? Tile::SolidRock : Tile::OpenGround);
 
   // Ensure connectivity.
   connectComponentsToMain(m);
@@ -209,12 +315,12 @@ void generateCavesModuleImpl(Map &m, const CavesOptions &opt,
 
 // New overload: accepts LevelConfig
 void generateCavesModule(Map &m, const config::LevelConfig &levelCfg,
-                         std::mt19937 &G) {
+                         core::Rng &G) {
   generateCavesModuleImpl(m, levelCfg.caves, levelCfg.cave_generation, G);
 }
 
 // Old overload: backward compatibility wrapper
-void generateCavesModule(Map &m, const CavesOptions &opt, std::mt19937 &G) {
+void generateCavesModule(Map &m, const CavesOptions &opt, core::Rng &G) {
   config::LevelConfig cfg;
   cfg.caves = opt;
   generateCavesModule(m, cfg, G);
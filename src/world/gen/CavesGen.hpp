@@ -7,7 +7,8 @@ namespace config {
 }
 #include "../Map.hpp"
 #include "GenOptions.hpp"
-#include <random>
+#include "core/BitGrid.hpp"
+#include "core/Rng.hpp"
 
 namespace world {
 struct CavesOptions : CommonGenOptions {
@@ -18,9 +19,16 @@ struct CavesOptions : CommonGenOptions {
 };
 
 
+// One cellular-automaton step on a packed wall bitmap (bit set = wall).
+// Wall survives with >= survive wall neighbours, floor becomes wall with
+// >= birth; border cells are always wall. 64 cells per word, neighbour
+// counts via bit-sliced adders. next must have the same size as cur.
+void cellularStep(const core::BitGrid &cur, core::BitGrid &next, int birth,
+                  int survive);
+
 // sygnatura modułu – bez zmian
-void generateCavesModule(Map &m, const CavesOptions &opt, std::mt19937 &rng);
+void generateCavesModule(Map &m, const CavesOptions &opt, core::Rng &rng);
 
 // New overload using LevelConfig
-void generateCavesModule(Map &m, const config::LevelConfig &cfg, std::mt19937 &rng);
+void generateCavesModule(Map &m, const config::LevelConfig &cfg, core::Rng &rng);
 } // namespace world
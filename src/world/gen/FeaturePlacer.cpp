@@ -7,7 +7,7 @@
 
 namespace world {
 
-FeaturePlacer::FeaturePlacer(std::mt19937 &rng) : rng_(rng) {}
+FeaturePlacer::FeaturePlacer(core::Rng &rng) : rng_(rng) {}
 
 void FeaturePlacer::placeDoors(Map &map, FeatureManager &features) {
   // Scan for valid door positions (wall between two floor tiles)
@@ -15,7 +15,7 @@ void FeaturePlacer::placeDoors(Map &map, FeatureManager &features) {
     for (int x = 1; x < map.width() - 1; ++x) {
       core::Position pos{x, y};
 
-      if (!blocksMovement(map.at(pos))) {
+      if (!map.blocksMovement(pos)) {
         continue; // Not a wall
       }
 
@@ -31,15 +31,15 @@ void FeaturePlacer::placeDoors(Map &map, FeatureManager &features) {
 bool FeaturePlacer::isValidDoorPosition(const Map &map,
                                         core::Position pos) const {
   // Must be on a wall
-  if (!blocksMovement(map.at(pos))) {
+  if (!map.blocksMovement(pos)) {
     return false;
   }
 
   // Check neighbors
-  const bool floorL = !blocksMovement(map.at({pos.x - 1, pos.y}));
-  const bool floorR = !blocksMovement(map.at({pos.x + 1, pos.y}));
-  const bool floorU = !blocksMovement(map.at({pos.x, pos.y - 1}));
-  const bool floorD = !blocksMovement(map.at({pos.x, pos.y + 1}));
+  const bool floorL = !map.blocksMovement({pos.x - 1, pos.y});
+  const bool floorR = !map.blocksMovement({pos.x + 1, pos.y});
+  const bool floorU = !map.blocksMovement({pos.x, pos.y - 1});
+  const bool floorD = !map.blocksMovement({pos.x, pos.y + 1});
 
   // Horizontal door: floor left and right, walls up and down
   const bool horiz = floorL && floorR && !floorU && !floorD;
@@ -65,9 +65,7 @@ FeaturePlacer::placeStairs(Map &map, FeatureManager &features, int target_depth,
   }
 
   // Shuffle candidates for randomness
-  std::shuffle(candidates.begin(), candidates.end(), rng_);
-
-  std::uniform_real_distribution<double> chance(0.0, 1.0);
+  rng_.shuffle(candidates.begin(), candidates.end());
 
   // Place first stairs (guaranteed if we have at least min_stairs candidates)
   if (!candidates.empty() &&
@@ -82,7 +80,7 @@ FeaturePlacer::placeStairs(Map &map, FeatureManager &features, int target_depth,
   // Place second stairs (probability-based)
   if (!candidates.empty() &&
       placed_stairs.size() < static_cast<size_t>(max_stairs) &&
-      chance(rng_) < second_stairs_chance) {
+      rng_.chance(second_stairs_chance)) {
 
     core::Position pos = candidates.back();
     candidates.pop_back();
@@ -94,7 +92,7 @@ FeaturePlacer::placeStairs(Map &map, FeatureManager &features, int target_depth,
   // Place third stairs (lower probability)
   if (!candidates.empty() &&
       placed_stairs.size() < static_cast<size_t>(max_stairs) &&
-      chance(rng_) < third_stairs_chance) {
+      rng_.chance(third_stairs_chance)) {
 
     core::Position pos = candidates.back();
     candidates.pop_back();
@@ -128,7 +126,7 @@ bool FeaturePlacer::isValidStairsPosition(const Map &map,
                                           const FeatureManager &features,
                                           core::Position pos) const {
   // Must be on floor
-  if (blocksMovement(map.at(pos))) {
+  if (map.blocksMovement(pos)) {
     return false;
   }
 
@@ -145,7 +143,7 @@ bool FeaturePlacer::isValidStairsPosition(const Map &map,
         continue;
 
       core::Position neighbor{pos.x + dx, pos.y + dy};
-      if (map.inBounds(neighbor) && !blocksMovement(map.at(neighbor))) {
+      if (map.inBounds(neighbor) && !map.blocksMovement(neighbor)) {
         walkable_neighbors++;
       }
     }
@@ -165,7 +163,7 @@ bool FeaturePlacer::isValidStairsPosition(const Map &map,
         continue;
 
       core::Position neighbor{pos.x + dx, pos.y + dy};
-      if (map.inBounds(neighbor) && blocksMovement(map.at(neighbor))) {
+      if (map.inBounds(neighbor) && map.blocksMovement(neighbor)) {
         wall_neighbors++;
       }
     }
@@ -197,7 +195,7 @@ std::vector<core::Position> FeaturePlacer::findValidSpawns(
       core::Position pos{x, y};
 
       // Must be floor
-      if (blocksMovement(map.at(pos))) {
+      if (map.blocksMovement(pos)) {
         continue;
       }
 
@@ -223,7 +221,7 @@ std::vector<core::Position> FeaturePlacer::findValidSpawns(
   }
 
   // Shuffle and take requested count
-  std::shuffle(all_candidates.begin(), all_candidates.end(), rng_);
+  rng_.shuffle(all_candidates.begin(), all_candidates.end());
 
   int to_take = std::min(count, static_cast<int>(all_candidates.size()));
   spawns.insert(spawns.end(), all_candidates.begin(),
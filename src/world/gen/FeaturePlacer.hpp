@@ -1,8 +1,8 @@
 #pragma once
 #include "core/Position.hpp"
+#include "core/Rng.hpp"
 #include "world/FeatureManager.hpp"
 #include "world/Map.hpp"
-#include <random>
 #include <vector>
 
 namespace world {
@@ -10,7 +10,7 @@ namespace world {
 // Places features (doors, stairs) on generated terrain
 class FeaturePlacer {
 public:
-  explicit FeaturePlacer(std::mt19937 &rng);
+  explicit FeaturePlacer(core::Rng &rng);
 
   // Place doors at corridor-room junctions
   void placeDoors(Map &map, FeatureManager &features);
@@ -40,7 +40,7 @@ private:
   std::vector<core::Position>
   findStairsCandidates(const Map &map, const FeatureManager &features) const;
 
-  std::mt19937 &rng_;
+  core::Rng &rng_;
 };
 
 } // namespace world
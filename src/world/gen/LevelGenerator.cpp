@@ -6,27 +6,32 @@
 
 namespace world {
 
-LevelGenerator::LevelGenerator(std::mt19937 &rng) : rng_(rng), placer_(rng) {}
+LevelGenerator::LevelGenerator(const core::Rng &rng) : rng_(rng) {}
 
 LevelData LevelGenerator::generateLevel(int width, int height, int depth,
                                         const config::LevelConfig &config) {
   // Create map and feature manager
   auto map = std::make_unique<Map>(width, height, Tile::SolidRock);
   auto features = std::make_unique<FeatureManager>();
+  features->attach(map.get());
+  core::Rng terrainRng = rng_.fork("terrain");
+  core::Rng featureRng = rng_.fork("features");
+  core::Rng spawnRng = rng_.fork("spawns");
 
   // Step 1: Generate terrain (only Floor and Wall)
-  generateTerrain(*map, config);
+  generateTerrain(*map, config, terrainRng);
 
   // Step 2: Place features (doors and stairs)
   int target_depth = depth + 1; // Stairs lead to next level
-  placeFeatures(*map, *features, target_depth, config);
+  placeFeatures(*map, *features, target_depth, config, featureRng);
 
   // Step 3: Create LevelData and find spawn points
   LevelData data(std::move(map), std::move(features));
   data.depth = depth;
 
-  // Find spawn points (20 monsters for now - could be config)
-  findSpawnPoints(*data.map, *data.features, data, 20);
+  // Find spawn points
+  findSpawnPoints(*data.map, *data.features, data, config.monster_count,
+                  spawnRng);
 
   return data;
 }
@@ -40,43 +45,50 @@ LevelData LevelGenerator::generateLevel(int width, int height, int depth) {
 }
 
 void LevelGenerator::generateTerrain(Map &map,
-                                     const config::LevelConfig &config) {
+                                     const config::LevelConfig &config,
+                                     core::Rng &rng) {
   // Choose generator based on config
   // mw: comented out all swtiches to leave with default only - testing
   //  switch (config.generator_type) {
   // case config::GeneratorType::Rooms:
-  //   generateRoomsModule(map, config, rng_);
+  //   generateRoomsModule(map, config, rng);
   //   break;
 
   // case config::GeneratorType::Caves:
-  //  generateCavesModule(map, config, rng_);
+  //  generateCavesModule(map, config, rng);
   //  break;
 
   // default:
   // Fallback to rooms if unknown type
-  generateRoomsModule(map, config, rng_);
+  generateRoomsModule(map, config, rng);
   //   break;
   // }
 }
 
 void LevelGenerator::placeFeatures(Map &map, FeatureManager &features,
                                    int target_depth,
-                                   const config::LevelConfig &config) {
+                                   const config::LevelConfig &config,
+                                   core::Rng &rng) {
+  FeaturePlacer placer(rng);
+
   // Place doors if enabled
   if (config.rooms.add_doors) {
-    placer_.placeDoors(map, features);
+    placer.placeDoors(map, features);
   }
 
   // Place stairs
   // TODO: Make stairs parameters configurable via config
-  placer_.placeStairs(map, features, target_depth, 1, 3, 0.15, 0.05);
+  placer.placeStairs(map, features, target_depth, 1, 3, 0.15, 0.05);
 }
 
 void LevelGenerator::findSpawnPoints(const Map &map,
                                      const FeatureManager &features,
-                                     LevelData &data, int monster_count) {
+                                     LevelData &data, int monster_count,
+                                     core::Rng &rng) {
+  FeaturePlacer placer(rng);
+
   // Find player spawn (single position, away from stairs)
-  auto player_spawns = placer_.findValidSpawns(map, features, 1, 5);
+  auto player_spawns = placer.findValidSpawns(map, features, 1, 5);
   if (!player_spawns.empty()) {
     data.player_spawn = player_spawns[0];
   } else {
@@ -94,7 +106,7 @@ void LevelGenerator::findSpawnPoints(const Map &map,
 
   // Find monster spawns (away from stairs)
   data.monster_spawns =
-      placer_.findValidSpawns(map, features, monster_count, 5);
+      placer.findValidSpawns(map, features, monster_count, 5);
 }
 
 } // namespace world
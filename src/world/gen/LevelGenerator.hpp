@@ -2,17 +2,21 @@
 #include "FeaturePlacer.hpp"
 #include "LevelData.hpp"
 #include "config/DungeonConfig.hpp"
+#include "core/Rng.hpp"
 #include "world/FeatureManager.hpp"
 #include "world/Map.hpp"
 #include <memory>
-#include <random>
 
 namespace world {
 
 // Main level generator - orchestrates terrain generation and feature placement
+// Each stage draws from its own sub-stream of the level's generator
+// ("terrain", "features", "spawns"), so changing how many numbers one
+// stage consumes does not reshuffle the others. The same Rng always
+// yields the same level.
 class LevelGenerator {
 public:
-  explicit LevelGenerator(std::mt19937 &rng);
+  explicit LevelGenerator(const core::Rng &rng);
 
   // Generate a complete level (map + features + spawn points)
   // Uses config to determine generator type and parameters
@@ -24,18 +28,18 @@ public:
 
 private:
   // Generate terrain only (no features)
-  void generateTerrain(Map &map, const config::LevelConfig &config);
+  void generateTerrain(Map &map, const config::LevelConfig &config,
+                       core::Rng &rng);
 
   // Place features (doors, stairs) on terrain
   void placeFeatures(Map &map, FeatureManager &features, int target_depth,
-                     const config::LevelConfig &config);
+                     const config::LevelConfig &config, core::Rng &rng);
 
   // Find spawn points for player and monsters
   void findSpawnPoints(const Map &map, const FeatureManager &features,
-                       LevelData &data, int monster_count);
+                       LevelData &data, int monster_count, core::Rng &rng);
 
-  std::mt19937 &rng_;
-  FeaturePlacer placer_;
+  core::Rng rng_;
 };
 
 } // namespace world
@@ -0,0 +1,88 @@
+#include "LevelPregenerator.hpp"
+#include "LevelGenerator.hpp"
+#include <chrono>
+#include <utility>
+
+namespace world {
+
+LevelPregenerator::LevelPregenerator(core::ThreadPool &pool,
+                                     std::uint64_t masterSeed, int width,
+                                     int height, config::LevelConfig config,
+                                     int lookahead)
+    : pool_(pool), masterSeed_(masterSeed), width_(width), height_(height),
+      config_(std::move(config)), lookahead_(lookahead) {}
+
+LevelPregenerator::~LevelPregenerator() { cancelAll(); }
+
+core::Rng LevelPregenerator::rngForDepth(std::uint64_t masterSeed,
+                                        int depth) noexcept {
+  return core::Rng(masterSeed)
+      .fork("level")
+      .stream(static_cast<std::uint64_t>(static_cast<std::int64_t>(depth)));
+}
+
+LevelData LevelPregenerator::generate(std::uint64_t masterSeed, int width,
+                                      int height, int depth,
+                                      const config::LevelConfig &config) {
+  LevelGenerator generator(rngForDepth(masterSeed, depth));
+  return generator.generateLevel(width, height, depth, config);
+}
+
+void LevelPregenerator::request(int depth) {
+  if (jobs_.count(depth))
+    return;
+
+  auto cancelled = std::make_shared<std::atomic<bool>>(false);
+  // The job owns copies of everything it reads, so it may outlive us
+  auto result = pool_.submit(
+      [cancelled, seed = masterSeed_, w = width_, h = height_, depth,
+       config = config_]() -> LevelData {
+        if (cancelled->load(std::memory_order_relaxed))
+          return {};
+        return generate(seed, w, h, depth, config);
+      });
+  jobs_.emplace(depth, Job{std::move(cancelled), std::move(result)});
+}
+
+bool LevelPregenerator::ready(int depth) const {
+  auto it = jobs_.find(depth);
+  return it != jobs_.end() &&
+         it->second.result.wait_for(std::chrono::seconds(0)) ==
+             std::future_status::ready;
+}
+
+LevelData LevelPregenerator::take(int depth) {
+  // Stale speculation (e.g. depths skipped over) is no longer useful
+  while (!jobs_.empty() && jobs_.begin()->first < depth)
+    cancel(jobs_.begin()->first);
+
+  // Queue the lookahead first so workers run while we wait below
+  for (int d = depth + 1; d <= depth + lookahead_; ++d)
+    request(d);
+
+  LevelData data;
+  auto it = jobs_.find(depth);
+  if (it != jobs_.end()) {
+    data = it->second.result.get();
+    jobs_.erase(it);
+  }
+  if (!data.map) // never queued, or cancelled before it started
+    data = generate(masterSeed_, width_, height_, depth, config_);
+  return data;
+}
+
+void LevelPregenerator::cancel(int depth) {
+  auto it = jobs_.find(depth);
+  if (it == jobs_.end())
+    return;
+  it->second.cancelled->store(true, std::memory_order_relaxed);
+  jobs_.erase(it); // future of a pool task does not block on destruction
+}
+
+void LevelPregenerator::cancelAll() {
+  for (auto &[depth, job] : jobs_)
+    job.cancelled->store(true, std::memory_order_relaxed);
+  jobs_.clear();
+}
+
+} // namespace world
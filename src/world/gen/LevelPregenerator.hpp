@@ -0,0 +1,75 @@
+#pragma once
+#include "LevelData.hpp"
+#include "config/DungeonConfig.hpp"
+#include "core/Rng.hpp"
+#include "core/ThreadPool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <memory>
+
+namespace world {
+
+// Speculative level generation on a thread pool.
+// Every depth gets its own Rng sub-stream of one master seed, so a level
+// is the same whether it was generated ahead of time on a worker or on
+// demand by take(). take(depth) hands over a finished level and queues
+// the next `lookahead` depths; levels no longer needed can be cancelled.
+// Not thread-safe itself - owned and driven by one thread.
+class LevelPregenerator {
+public:
+  LevelPregenerator(core::ThreadPool &pool, std::uint64_t masterSeed,
+                    int width, int height,
+                    config::LevelConfig config = config::largeDungeon(),
+                    int lookahead = 2);
+  ~LevelPregenerator();
+
+  LevelPregenerator(const LevelPregenerator &) = delete;
+  LevelPregenerator &operator=(const LevelPregenerator &) = delete;
+
+  // Generator for one depth: Rng(masterSeed).fork("level").stream(depth)
+  static core::Rng rngForDepth(std::uint64_t masterSeed, int depth) noexcept;
+
+  // Synchronous generation of one depth - what every worker job runs
+  static LevelData generate(std::uint64_t masterSeed, int width, int height,
+                            int depth, const config::LevelConfig &config);
+
+  // Queues generation of depth unless already queued or finished
+  void request(int depth);
+
+  // True when the level for depth is generated and can be taken at once
+  bool ready(int depth) const;
+
+  // Returns the level for depth: waits for a queued job, or generates it
+  // on the calling thread if none was queued. Afterwards queues
+  // depth+1 .. depth+lookahead and cancels jobs for shallower depths.
+  LevelData take(int depth);
+
+  // Drops the job for one depth / all jobs. A job that has not started
+  // yet is skipped by its worker; one already running finishes unused.
+  void cancel(int depth);
+  void cancelAll();
+
+  // Jobs queued or finished and not yet taken
+  std::size_t pending() const noexcept { return jobs_.size(); }
+
+  std::uint64_t masterSeed() const noexcept { return masterSeed_; }
+  int lookahead() const noexcept { return lookahead_; }
+
+private:
+  struct Job {
+    std::shared_ptr<std::atomic<bool>> cancelled;
+    std::future<LevelData> result;
+  };
+
+  core::ThreadPool &pool_;
+  std::uint64_t masterSeed_;
+  int width_;
+  int height_;
+  config::LevelConfig config_;
+  int lookahead_;
+  std::map<int, Job> jobs_; // by depth
+};
+
+} // namespace world
@@ -2,21 +2,16 @@
 #include "MapGenerator.hpp"
 #include "RoomsGen.hpp"
 #include <algorithm>
+#include <random>
 
 using namespace world;
 
 namespace world {
 
-MapGenerator::MapGenerator(unsigned int seed) {
-  if (seed == 0) {
-    std::random_device rd;
-    rng_.seed(rd());
-  } else {
-    rng_.seed(seed);
-  }
-}
+MapGenerator::MapGenerator(uint32_t seed)
+    : rng_(seed != 0 ? seed : std::random_device{}()) {}
 
-std::mt19937 &MapGenerator::rng() { return rng_; }
+core::Rng &MapGenerator::rng() { return rng_; }
 
 void MapGenerator::generateRooms(Map &m, const RoomsOptions &opt) {
   generateRoomsModule(m, opt, rng_);
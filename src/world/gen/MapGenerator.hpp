@@ -1,6 +1,7 @@
 #pragma once
+#include "core/Rng.hpp"
 #include "world/Map.hpp"
-#include <random>
+#include <cstdint>
 
 namespace world {
 struct RoomsOptions; // forward
@@ -15,7 +16,7 @@ public:
 private:
   void resetToWalls(Map &m);
   void placeDoors(Map &m);
-  std::mt19937 &rng();
-  std::mt19937 rng_;
+  core::Rng &rng();
+  core::Rng rng_;
 };
 } // namespace world
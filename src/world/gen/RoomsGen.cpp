@@ -66,10 +66,10 @@ void digToEdgeV(world::Map &m, int y0, int y1, int x) {
 }
 
 void carveLCorridorStop(world::Map &m, core::Position a, core::Position b,
-                        std::mt19937 &G) {
+                        core::Rng &G) {
   if (a.x == b.x && a.y == b.y)
     return;
-  if (std::uniform_int_distribution<int>(0, 1)(G) == 0) {
+  if (G.uniformInt(0, 1) == 0) {
     digToEdgeH(m, a.x, b.x, a.y);
     digToEdgeV(m, a.y, b.y, b.x);
   } else {
@@ -113,16 +113,13 @@ namespace world {
 
 void generateRoomsModuleImpl(Map &m, const RoomsOptions &optIn,
                              const ::config::RoomPlacementConfig &placement,
-                             std::mt19937 &G) {
+                             core::Rng &G) {
 
   m.fill(Tile::SolidRock);
 
   RoomsOptions opt = optIn;
   normalize_rooms_options(opt, placement, m);
 
-  std::uniform_int_distribution<int> rw(opt.room_min, opt.room_max);
-  std::uniform_int_distribution<int> rh(opt.room_min, opt.room_max);
-
   std::vector<Rect> rooms;
   rooms.reserve(static_cast<size_t>(opt.max_rooms));
 
@@ -132,16 +129,17 @@ void generateRoomsModuleImpl(Map &m, const RoomsOptions &optIn,
 
   // Placement loop with attempts budget.
   for (int i = 0; i < attempts && placed < opt.max_rooms; ++i) {
-    int w = rw(G), h = rh(G);
+    int w = G.uniformInt(opt.room_min, opt.room_max);
+    int h = G.uniformInt(opt.room_min, opt.room_max);
     if (w >= m.width() - placement.edge_margin ||
         h >= m.height() - placement.edge_margin)
       continue;
 
-    std::uniform_int_distribution<int> rx(
-        1, std::max(1, m.width() - w - placement.edge_margin));
-    std::uniform_int_distribution<int> ry(
-        1, std::max(1, m.height() - h - placement.edge_margin));
-    Rect r{rx(G), ry(G), w, h};
+    const int x =
+        G.uniformInt(1, std::max(1, m.width() - w - placement.edge_margin));
+    const int y =
+        G.uniformInt(1, std::max(1, m.height() - h - placement.edge_margin));
+    Rect r{x, y, w, h};
 
     // 1-tile buffer — rooms won’t merge into one blob.
     if (!areaIsAllWalls(m, r, placement.room_padding))
@@ -165,12 +163,12 @@ void generateRoomsModuleImpl(Map &m, const RoomsOptions &optIn,
 }
 // New overload: accepts LevelConfig
 void generateRoomsModule(Map &m, const config::LevelConfig &levelCfg,
-                         std::mt19937 &G) {
+                         core::Rng &G) {
   generateRoomsModuleImpl(m, levelCfg.rooms, levelCfg.room_placement, G);
 }
 
 // Old overload: backward compatibility wrapper
-void generateRoomsModule(Map &m, const RoomsOptions &opt, std::mt19937 &G) {
+void generateRoomsModule(Map &m, const RoomsOptions &opt, core::Rng &G) {
   config::LevelConfig cfg;
   cfg.rooms = opt;
   generateRoomsModule(m, cfg, G);
@@ -7,7 +7,7 @@ struct RoomPlacementConfig;
 } // namespace config
 #include "../Map.hpp"
 #include "GenOptions.hpp"
-#include <random>
+#include "core/Rng.hpp"
 
 namespace world {
 struct RoomsOptions : CommonGenOptions {
@@ -17,10 +17,10 @@ struct RoomsOptions : CommonGenOptions {
 };
 
 // sygnatura modułu – bez zmian
-void generateRoomsModule(Map &m, const RoomsOptions &opt, std::mt19937 &rng);
+void generateRoomsModule(Map &m, const RoomsOptions &opt, core::Rng &rng);
 
 // New overload using LevelConfig
 void generateRoomsModule(Map &m, const config::LevelConfig &cfg,
-                         std::mt19937 &rng);
+                         core::Rng &rng);
 
 } // namespace world
@@ -0,0 +1,73 @@
+#include "../src/entities/ActorStore.hpp"
+#include "../src/systems/ActorSystems.hpp"
+#include "../src/world/Map.hpp"
+#include "../src/world/TileRegistry.hpp"
+#include "include/assertions.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+int main() {
+  using entities::ActorStore;
+  using systems::ActorSystems;
+
+  ActorStore actors;
+
+  // Test 1: Create actors with different components
+  core::EntityId a = actors.create(entities::CPosition | entities::CSpeed);
+  core::EntityId b = actors.create(entities::CSpeed);
+  core::EntityId c = actors.create(entities::CGlyph);
+  EXPECT_EQ(actors.size(), 3u);
+  actors.speed()[actors.indexOf(a)] = 100;
+  actors.speed()[actors.indexOf(b)] = 50;
+  actors.glyphs()[actors.indexOf(c)] = 'g';
+
+  // Test 2: Component query visits only matching actors
+  int withSpeed = 0;
+  actors.each(entities::CSpeed, [&](std::size_t) { ++withSpeed; });
+  EXPECT_EQ(withSpeed, 2);
+
+  // Test 3: Energy accumulation
+  EXPECT_EQ(ActorSystems::accumulateEnergy(actors), 1u);
+  EXPECT_EQ(ActorSystems::accumulateEnergy(actors), 2u);
+  EXPECT_EQ(actors.energy()[actors.indexOf(b)], 100);
+
+  // Test 4: Destroy swaps last actor in, handles stay valid
+  actors.destroy(a);
+  EXPECT_TRUE(!actors.alive(a));
+  EXPECT_TRUE(actors.alive(c));
+  EXPECT_EQ(actors.size(), 2u);
+  EXPECT_EQ(actors.glyphs()[actors.indexOf(c)], 'g');
+  EXPECT_EQ(actors.speed()[actors.indexOf(b)], 50);
+
+  // Test 5: Slot reuse gets a new generation
+  core::EntityId d = actors.create(entities::CPosition);
+  EXPECT_EQ(d.index, a.index);
+  EXPECT_TRUE(actors.alive(d) && !actors.alive(a));
+
+  // Test 6: Terrain damage per turn
+  world::TileRegistry::instance().registerTile(
+      world::Tile::ShallowLiquid, world::TileProperties{200, false, 0, 5});
+  world::Map map(4, 1, world::Tile::OpenGround);
+  map.set({2, 0}, world::Tile::ShallowLiquid);
+
+  ActorStore crowd;
+  core::EntityId wet = crowd.create(entities::CPosition | entities::CHealth);
+  core::EntityId dry = crowd.create(entities::CPosition | entities::CHealth);
+  crowd.positions()[crowd.indexOf(wet)] = {2, 0};
+  crowd.hp()[crowd.indexOf(wet)] = 7;
+  crowd.positions()[crowd.indexOf(dry)] = {1, 0};
+  crowd.hp()[crowd.indexOf(dry)] = 7;
+
+  std::vector<core::EntityId> killed;
+  ActorSystems::applyTerrainDamage(crowd, map, killed);
+  EXPECT_EQ(crowd.hp()[crowd.indexOf(wet)], 2);
+  EXPECT_EQ(crowd.hp()[crowd.indexOf(dry)], 7);
+  EXPECT_TRUE(killed.empty());
+  ActorSystems::applyTerrainDamage(crowd, map, killed);
+  EXPECT_EQ(killed.size(), 1u);
+  EXPECT_TRUE(killed[0] == wet);
+
+  std::cout << "ActorStore tests passed.\n";
+  return EXIT_SUCCESS;
+}
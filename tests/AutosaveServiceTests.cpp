@@ -0,0 +1,104 @@
+#include "../src/serialization/AtomicFile.hpp"
+#include "../src/serialization/AutosaveService.hpp"
+#include "../src/serialization/Gameserialization.hpp"
+#include "include/assertions.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+serialization::SaveSnapshot makeSnapshot(world::Map &map,
+                                         world::FeatureManager &features,
+                                         entities::EntityManager &entities,
+                                         int turn) {
+  serialization::SaveSnapshot snapshot;
+  snapshot.turn_counter = turn;
+  snapshot.levels.push_back(serialization::snapshotLevel(
+      map, features, entities,
+      std::vector<bool>(static_cast<std::size_t>(map.width() * map.height())),
+      3));
+  return snapshot;
+}
+
+bool fileExists(const std::string &name) {
+  return std::ifstream(name).good();
+}
+
+} // namespace
+
+int main() {
+  using serialization::AutosaveService;
+  const std::string filename = "test_autosave.sav";
+
+  world::Map map(32, 16, world::Tile::OpenGround);
+  world::FeatureManager features;
+  features.addFeature({4, 4}, world::Door{world::Door::Material::Wood,
+                                          world::Door::State::Closed});
+  entities::EntityManager entities;
+  entities.createEntity("Player", core::Position{1, 1});
+
+  // Test 1: Atomic write replaces the file and leaves no temporary
+  const std::vector<std::uint8_t> first = {1, 2, 3};
+  const std::vector<std::uint8_t> second = {4, 5};
+  serialization::writeFileAtomic(filename, first);
+  serialization::writeFileAtomic(filename, second,
+                                 serialization::FsyncPolicy::None);
+  {
+    std::ifstream in(filename, std::ios::binary);
+    EXPECT_EQ(in.get(), 4);
+    EXPECT_EQ(in.get(), 5);
+    EXPECT_EQ(in.get(), EOF);
+  }
+  EXPECT_TRUE(!fileExists(filename + ".tmp"));
+
+  // Test 2: A snapshot is detached from the live level
+  {
+    AutosaveService service(filename);
+    EXPECT_TRUE(service.submit(makeSnapshot(map, features, entities, 10)));
+    map.set({7, 7}, world::Tile::SolidRock); // after the snapshot
+    service.wait();
+    EXPECT_EQ(service.saved(), 1u);
+    EXPECT_TRUE(!service.busy());
+  }
+  {
+    serialization::SaveData loaded = serialization::loadGame(filename);
+    EXPECT_EQ(loaded.turn_counter, 10);
+    EXPECT_EQ(loaded.visited_levels.size(), 1u);
+    EXPECT_EQ(loaded.visited_levels[0].depth, 3);
+    EXPECT_TRUE(loaded.visited_levels[0].map.at({7, 7}) ==
+                world::Tile::OpenGround);
+    EXPECT_EQ(loaded.visited_levels[0].features.size(), 1u);
+    EXPECT_EQ(loaded.visited_levels[0].entities.count(), 1u);
+  }
+
+  // Test 3: Only one save in flight; the rest are refused, not queued
+  {
+    AutosaveService service(filename, serialization::FsyncPolicy::None);
+    EXPECT_TRUE(service.submit(makeSnapshot(map, features, entities, 20)));
+    const bool accepted =
+        service.submit(makeSnapshot(map, features, entities, 21));
+    EXPECT_EQ(service.skipped(), accepted ? 0u : 1u);
+    service.wait();
+    EXPECT_EQ(service.saved(), accepted ? 2u : 1u);
+    EXPECT_EQ(serialization::loadGame(filename).turn_counter,
+              accepted ? 21 : 20);
+  }
+
+  // Test 4: Failures are reported, not thrown at the game thread
+  {
+    AutosaveService service("no_such_dir/test_autosave.sav");
+    EXPECT_TRUE(service.submit(makeSnapshot(map, features, entities, 30)));
+    service.wait();
+    EXPECT_EQ(service.saved(), 0u);
+    EXPECT_EQ(service.failed(), 1u);
+    EXPECT_TRUE(service.lastError().find("Failed to open") !=
+                std::string::npos);
+  }
+
+  std::remove(filename.c_str());
+  std::cout << "AutosaveService tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,49 @@
+#include "../src/core/BitGrid.hpp"
+#include "include/assertions.hpp"
+#include <iostream>
+#include <vector>
+
+int main() {
+  using core::BitGrid;
+
+  // Test 1: Empty grid, width spans several words
+  BitGrid grid(130, 5);
+  EXPECT_EQ(grid.wordsPerRow(), 3u);
+  EXPECT_EQ(grid.count(), 0u);
+
+  // Test 2: Set / test / reset across word boundaries
+  grid.set(0, 0);
+  grid.set(63, 1);
+  grid.set(64, 1);
+  grid.set(129, 4);
+  EXPECT_TRUE(grid.test(63, 1));
+  EXPECT_TRUE(grid.test(64, 1));
+  EXPECT_TRUE(!grid.test(65, 1));
+  EXPECT_EQ(grid.count(), 4u);
+  grid.reset(0, 0);
+  EXPECT_TRUE(!grid.test(0, 0));
+
+  // Test 3: Iteration visits set cells in row-major order
+  std::vector<int> xs;
+  grid.forEachSet([&](int x, int) { xs.push_back(x); });
+  EXPECT_EQ(xs.size(), 3u);
+  EXPECT_EQ(xs[0], 63);
+  EXPECT_EQ(xs[1], 64);
+  EXPECT_EQ(xs[2], 129);
+
+  // Test 4: Rect iteration and clear only touch the rectangle
+  int inRect = 0;
+  grid.forEachSetInRect(60, 0, 64, 3, [&](int, int) { ++inRect; });
+  EXPECT_EQ(inRect, 2);
+  grid.clearRect(64, 0, 200, 3);
+  EXPECT_TRUE(grid.test(63, 1));
+  EXPECT_TRUE(!grid.test(64, 1));
+  EXPECT_TRUE(grid.test(129, 4));
+
+  // Test 5: Fill keeps padding bits clear
+  BitGrid full(70, 2, true);
+  EXPECT_EQ(full.count(), 140u);
+
+  std::cout << "BitGrid tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,111 @@
+#include "../src/core/BitGrid.hpp"
+#include "../src/core/Rng.hpp"
+#include "../src/world/Map.hpp"
+#include "../src/world/gen/CavesGen.hpp"
+#include "include/assertions.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Straightforward per-cell CA step, reference for the bit-parallel one
+bool naiveNext(const core::BitGrid &g, int x, int y, int birth,
+               int survive) {
+  if (x == 0 || y == 0 || x == g.width() - 1 || y == g.height() - 1)
+    return true;
+  int walls = 0;
+  for (int dy = -1; dy <= 1; ++dy)
+    for (int dx = -1; dx <= 1; ++dx)
+      if ((dx != 0 || dy != 0) && g.test(x + dx, y + dy))
+        ++walls;
+  return g.test(x, y) ? walls >= survive : walls >= birth;
+}
+
+// Number of 4-connected floor regions
+int countRegions(const world::Map &m) {
+  core::BitGrid seen(m.width(), m.height());
+  std::vector<core::Position> stack;
+  int regions = 0;
+  for (int y = 0; y < m.height(); ++y)
+    for (int x = 0; x < m.width(); ++x) {
+      if (m.at({x, y}) != world::Tile::OpenGround || seen.test(x, y))
+        continue;
+      ++regions;
+      seen.set(x, y);
+      stack.push_back({x, y});
+      while (!stack.empty()) {
+        const core::Position p = stack.back();
+        stack.pop_back();
+        const core::Position next[4] = {
+            {p.x + 1, p.y}, {p.x - 1, p.y}, {p.x, p.y + 1}, {p.x, p.y - 1}};
+        for (const core::Position &q : next)
+          if (m.inBounds(q.x, q.y) &&
+              m.at({q.x, q.y}) == world::Tile::OpenGround &&
+              !seen.test(q.x, q.y)) {
+            seen.set(q.x, q.y);
+            stack.push_back(q);
+          }
+      }
+    }
+  return regions;
+}
+
+} // namespace
+
+int main() {
+  // Test 1: Bit-parallel step matches per-cell rule (width spans words)
+  std::mt19937 rng(7);
+  std::bernoulli_distribution coin(0.45);
+  for (int birth = 3; birth <= 6; ++birth) {
+    core::BitGrid cur(130, 17);
+    for (int y = 0; y < cur.height(); ++y)
+      for (int x = 0; x < cur.width(); ++x)
+        cur.assign(x, y, coin(rng));
+
+    core::BitGrid next(130, 17);
+    world::cellularStep(cur, next, birth, 4);
+    for (int y = 0; y < cur.height(); ++y)
+      for (int x = 0; x < cur.width(); ++x)
+        EXPECT_EQ(next.test(x, y), naiveNext(cur, x, y, birth, 4));
+  }
+
+  // Test 2: Padding bits stay clear
+  core::BitGrid full(70, 5, true);
+  core::BitGrid out(70, 5);
+  world::cellularStep(full, out, 5, 4);
+  EXPECT_EQ(out.count(), 350u);
+
+  // Test 3: Generated caves have solid border and some floor
+  core::Rng gen(1337);
+  world::Map m(80, 50);
+  world::CavesOptions opt;
+  opt.fill_percent = 45;
+  world::generateCavesModule(m, opt, gen);
+  int floors = 0;
+  for (int y = 0; y < m.height(); ++y)
+    for (int x = 0; x < m.width(); ++x) {
+      const bool border =
+          x == 0 || y == 0 || x == m.width() - 1 || y == m.height() - 1;
+      if (border)
+        EXPECT_TRUE(m.at({x, y}) == world::Tile::SolidRock);
+      else if (m.at({x, y}) == world::Tile::OpenGround)
+        ++floors;
+    }
+  EXPECT_TRUE(floors > 0);
+
+  // Test 4: Every cave is one connected region (sparse fill leaves many
+  // islands to join)
+  for (unsigned seed = 1; seed <= 5; ++seed) {
+    core::Rng g(seed);
+    world::Map big(200, 150);
+    world::CavesOptions sparse;
+    sparse.fill_percent = 58;
+    world::generateCavesModule(big, sparse, g);
+    EXPECT_EQ(countRegions(big), 1);
+  }
+
+  std::cout << "CavesGen tests passed.\n";
+  return EXIT_SUCCESS;
+}
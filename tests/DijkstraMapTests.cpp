@@ -0,0 +1,132 @@
+#include "../src/core/DijkstraMap.hpp"
+#include "../src/core/Pathfinding.hpp"
+#include "../src/core/Position.hpp"
+#include "../src/world/FeatureManager.hpp"
+#include "../src/world/LevelView.hpp"
+#include "../src/world/Map.hpp"
+#include "../src/world/MapViewAdapter.hpp"
+#include "../src/world/Tile.hpp"
+#include "include/assertions.hpp"
+#include <cstdlib>
+#include <iostream>
+
+int main() {
+  using core::DijkstraMap;
+  using world::Map;
+  using world::MapViewAdapter;
+  using world::Tile;
+
+  // 10x10 room with wall border and a partial wall at x = 5
+  Map m(10, 10, Tile::OpenGround);
+  for (int x = 0; x < m.width(); ++x) {
+    m.set({x, 0}, Tile::SolidRock);
+    m.set({x, m.height() - 1}, Tile::SolidRock);
+  }
+  for (int y = 0; y < m.height(); ++y) {
+    m.set({0, y}, Tile::SolidRock);
+    m.set({m.width() - 1, y}, Tile::SolidRock);
+  }
+  for (int y = 1; y < 8; ++y)
+    m.set({5, y}, Tile::SolidRock);
+
+  MapViewAdapter view(m);
+  DijkstraMap dmap(view);
+
+  // Test 1: Goal is 0, walls unreachable, neighbors 1
+  dmap.addGoal({2, 2});
+  dmap.compute();
+  EXPECT_EQ(dmap.valueAt(2, 2), 0);
+  EXPECT_EQ(dmap.valueAt(3, 3), 1);
+  EXPECT_TRUE(!dmap.isReachable(5, 4));
+  EXPECT_TRUE(!dmap.isReachable(0, 0));
+  EXPECT_TRUE(!dmap.isReachable(-1, 3));
+
+  // Test 2: Distance matches A* path length around the wall
+  core::Pathfinding pathfinder(view);
+  auto path = pathfinder.findPath({2, 2}, {7, 2});
+  EXPECT_TRUE(!path.empty());
+  EXPECT_EQ(dmap.valueAt(7, 2), static_cast<int>(path.size()) - 1);
+
+  // Test 3: Steepest descent walks to the goal in exactly that many steps
+  core::Position pos{7, 2};
+  int steps = 0;
+  while (auto next = dmap.nextStep(pos)) {
+    pos = *next;
+    ++steps;
+  }
+  EXPECT_EQ(pos.x, 2);
+  EXPECT_EQ(pos.y, 2);
+  EXPECT_EQ(steps, dmap.valueAt(7, 2));
+
+  // Test 4: Multiple goals - each cell takes the nearest one
+  dmap.clearGoals();
+  dmap.addGoal({1, 1});
+  dmap.addGoal({8, 1});
+  dmap.compute();
+  EXPECT_EQ(dmap.valueAt(7, 1), 1);
+  EXPECT_EQ(dmap.valueAt(2, 1), 1);
+
+  // Test 5: Goal values bias the field
+  dmap.clearGoals();
+  dmap.addGoal({1, 1}, 0);
+  dmap.addGoal({3, 1}, -5);
+  dmap.compute();
+  EXPECT_EQ(dmap.valueAt(1, 1), -3);
+
+  // Test 6: Rejected neighbors are skipped by nextStep
+  dmap.clearGoals();
+  dmap.addGoal({1, 1});
+  dmap.compute();
+  auto blocked = dmap.nextStep({3, 1}, [](const core::Position &p) {
+    return !(p.x == 2 && p.y == 1) && !(p.x == 2 && p.y == 2);
+  });
+  EXPECT_TRUE(!blocked.has_value());
+
+  // Test 7: Inverted map leads away from the goal
+  dmap.invert();
+  auto away = dmap.nextStep({2, 2});
+  EXPECT_TRUE(away.has_value());
+  EXPECT_TRUE(away->x + away->y > 4);
+
+  // Test 8: Over LevelView, cells that block movement but not sight
+  // (deep liquid, closed doors) are walls, as for BasicPathfinding
+  {
+    Map pool(7, 3, Tile::OpenGround);
+    for (int y = 0; y < 2; ++y)
+      pool.set({3, y}, Tile::DeepLiquid);
+    world::FeatureManager features;
+    features.attach(&pool);
+    features.addFeature({3, 2}, world::Door{world::Door::Material::Wood,
+                                            world::Door::State::Closed});
+    world::LevelView level(pool, features);
+    core::BasicDijkstraMap<world::LevelView> chase(level);
+    chase.addGoal({6, 1});
+    chase.compute();
+    EXPECT_TRUE(!chase.isReachable(3, 1));
+    EXPECT_TRUE(!chase.isReachable(0, 1)); // liquid and door cut the room
+
+    features.setDoorState({3, 2}, world::Door::State::Open);
+    chase.compute();
+    EXPECT_TRUE(!chase.isReachable(3, 0));
+    EXPECT_EQ(chase.valueAt(0, 1), 6);
+    core::BasicPathfinding<world::LevelView> astar(level);
+    core::Position at{0, 1};
+    while (auto next = chase.nextStep(at)) {
+      EXPECT_TRUE(!level.blocksMovement(next->x, next->y));
+      at = *next;
+    }
+    EXPECT_TRUE(at == core::Position(6, 1));
+    EXPECT_EQ(chase.valueAt(0, 1),
+              static_cast<int>(astar.findPath({0, 1}, {6, 1}).size()) - 1);
+
+    // The sight-only IMapView instantiation still walks through liquid
+    MapViewAdapter sightOnly(pool);
+    DijkstraMap sight(sightOnly);
+    sight.addGoal({6, 1});
+    sight.compute();
+    EXPECT_TRUE(sight.isReachable(3, 1));
+  }
+
+  std::cout << "DijkstraMap tests passed.\n";
+  return EXIT_SUCCESS;
+}
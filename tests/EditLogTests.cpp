@@ -0,0 +1,39 @@
+#include "../src/core/EditLog.hpp"
+#include "include/assertions.hpp"
+#include <iostream>
+
+int main() {
+  using core::EditLog;
+
+  // Test 1: Fresh log reports nothing
+  EditLog log(4);
+  EXPECT_EQ(log.revision(), 0u);
+  EXPECT_TRUE(!log.changedSince(0, 0, 0, 100, 100));
+
+  // Test 2: Edits are found only inside the rectangle
+  log.record(5, 5);
+  const std::uint64_t afterFirst = log.revision();
+  log.record(20, 3);
+  EXPECT_EQ(log.revision(), 2u);
+  EXPECT_TRUE(log.changedSince(0, 0, 0, 10, 10));
+  EXPECT_TRUE(!log.changedSince(afterFirst, 0, 0, 10, 10));
+  EXPECT_TRUE(log.changedSince(afterFirst, 15, 0, 25, 5));
+  EXPECT_TRUE(!log.changedSince(log.revision(), 0, 0, 100, 100));
+
+  // Test 3: Overwritten edits make old revisions answer conservatively
+  const std::uint64_t before = log.revision();
+  for (int i = 0; i < 5; ++i)
+    log.record(90, 90);
+  EXPECT_TRUE(log.changedSince(before, 0, 0, 10, 10));
+  EXPECT_TRUE(!log.changedSince(log.revision() - 2, 0, 0, 10, 10));
+
+  // Test 4: recordAll() touches every rectangle
+  const std::uint64_t beforeAll = log.revision();
+  log.recordAll();
+  log.record(90, 90);
+  EXPECT_TRUE(log.changedSince(beforeAll, 0, 0, 1, 1));
+  EXPECT_TRUE(!log.changedSince(log.revision() - 1, 0, 0, 1, 1));
+
+  std::cout << "EditLog tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -3,7 +3,8 @@
 #include "../src/entities/EntityManager.hpp"
 #include "include/assertions.hpp"
 #include <iostream>
-#include <memory>
+#include <utility>
+#include <vector>
 
 int main() {
   using entities::Entity;
@@ -16,14 +17,10 @@ int main() {
   EXPECT_TRUE(manager.getEntityAt({5, 5}) == nullptr);
 
   // Test 2: Add entities
-  auto player = std::make_unique<Entity>("Player", core::Position{5, 5});
-  Entity *playerPtr = player.get();
-  manager.addEntity(std::move(player));
+  Entity *playerPtr = &manager.createEntity("Player", core::Position{5, 5});
   EXPECT_EQ(manager.count(), 1);
 
-  auto goblin = std::make_unique<Entity>("Goblin", core::Position{10, 10});
-  Entity *goblinPtr = goblin.get();
-  manager.addEntity(std::move(goblin));
+  Entity *goblinPtr = &manager.createEntity("Goblin", core::Position{10, 10});
   EXPECT_EQ(manager.count(), 2);
 
   // Test 3: Get entity at position
@@ -36,8 +33,7 @@ int main() {
   EXPECT_TRUE(manager.getEntityAt({0, 0}) == nullptr);
 
   // Test 5: Multiple entities at same position
-  auto orc = std::make_unique<Entity>("Orc", core::Position{5, 5});
-  manager.addEntity(std::move(orc));
+  manager.createEntity("Orc", core::Position{5, 5});
   auto entities = manager.getEntitiesAt({5, 5});
   EXPECT_EQ(entities.size(), 2);
 
@@ -46,9 +42,84 @@ int main() {
   EXPECT_EQ(manager.count(), 2);
   EXPECT_TRUE(manager.getEntityAt({10, 10}) == nullptr);
 
-  // Test 7: Clear all
+  // Test 7: Moving an entity updates the index
+  playerPtr->setPosition({6, 5});
+  EXPECT_TRUE(manager.getEntityAt({6, 5}) == playerPtr);
+  EXPECT_EQ(manager.getEntitiesAt({5, 5}).size(), 1);
+
+  // Test 8: Range and radius queries
+  manager.createEntity("Rat", core::Position{8, 8});
+  EXPECT_EQ(manager.getEntitiesInRect({4, 4}, {6, 6}).size(), 2);
+  EXPECT_EQ(manager.getEntitiesInRadius({6, 6}, 1).size(), 2);
+  EXPECT_EQ(manager.getEntitiesInRadius({6, 6}, 2).size(), 3);
+
+  // Test 9: Positions outside the initial grid (negative / far away)
+  playerPtr->setPosition({-3, 2});
+  EXPECT_TRUE(manager.getEntityAt({-3, 2}) == playerPtr);
+  playerPtr->setPosition({500, 300});
+  EXPECT_TRUE(manager.getEntityAt({500, 300}) == playerPtr);
+  EXPECT_TRUE(manager.getEntityAt({8, 8}) != nullptr);
+
+  // Test 10: Index follows the manager when moved
+  EntityManager moved(std::move(manager));
+  playerPtr->setPosition({1, 1});
+  EXPECT_TRUE(moved.getEntityAt({1, 1}) == playerPtr);
+  manager = std::move(moved);
+  EXPECT_TRUE(manager.getEntityAt({1, 1}) == playerPtr);
+
+  // Test 11: Handles resolve, go stale on removal, slots are reused
+  Entity *batPtr = &manager.createEntity("Bat", core::Position{2, 2});
+  core::EntityId batId = batPtr->getId();
+  EXPECT_TRUE(batId.valid());
+  EXPECT_TRUE(batPtr->getId() == batId);
+  EXPECT_TRUE(manager.get(batId) == batPtr);
+  manager.removeEntity(batId);
+  EXPECT_TRUE(!manager.contains(batId));
+  EXPECT_TRUE(manager.getEntityAt({2, 2}) == nullptr);
+  Entity owl("Owl", core::Position{2, 2});
+  owl.setHP(3);
+  core::EntityId owlId = manager.addEntity(std::move(owl));
+  EXPECT_EQ(owlId.index, batId.index);
+  EXPECT_TRUE(owlId != batId);
+  EXPECT_TRUE(manager.get(batId) == nullptr);
+  // Moved into the pool cell the bat left behind
+  EXPECT_TRUE(manager.get(owlId) == batPtr);
+  EXPECT_EQ(manager.get(owlId)->getHP(), 3);
+  EXPECT_TRUE(manager.getEntityAt({2, 2}) == batPtr);
+
+  // Test 12: Swap-and-pop keeps remaining handles valid
+  EXPECT_TRUE(manager.get(playerPtr->getId()) == playerPtr);
+  manager.removeEntity(playerPtr);
+  EXPECT_TRUE(manager.get(owlId) != nullptr);
+  EXPECT_EQ(manager.get(owlId)->getName(), "Owl");
+
+  // Test 13: Revision tracks changes to owned entities
+  Entity *owlPtr = manager.get(owlId);
+  std::uint64_t revision = manager.revision();
+  owlPtr->setPosition({3, 2});
+  EXPECT_TRUE(manager.revision() > revision);
+  revision = manager.revision();
+  owlPtr->set(entities::Prop::HP, 7);
+  EXPECT_TRUE(manager.revision() > revision);
+  revision = manager.revision();
+  EXPECT_EQ(owlPtr->get(entities::Prop::HP), 7);
+  EXPECT_EQ(manager.revision(), revision); // reads do not count
+
+  // Test 14: Pool growth never moves live entities
+  const std::size_t before = manager.count();
+  std::vector<Entity *> crowd;
+  for (int i = 0; i < 300; ++i)
+    crowd.push_back(&manager.createEntity("Rat", core::Position{i % 40, 9}));
+  EXPECT_TRUE(manager.get(owlId) == owlPtr);
+  for (Entity *rat : crowd)
+    EXPECT_TRUE(manager.get(rat->getId()) == rat);
+  EXPECT_EQ(manager.getEntities().size(), before + 300);
+
+  // Test 15: Clear all
   manager.clear();
   EXPECT_EQ(manager.count(), 0);
+  EXPECT_TRUE(manager.revision() > revision);
+  EXPECT_TRUE(manager.get(owlId) == nullptr);
 
   std::cout << "EntityManager tests passed.\n";
   return EXIT_SUCCESS;
@@ -41,6 +41,20 @@ int main() {
   EXPECT_EQ(goblin.getName(), "Goblin");
   EXPECT_EQ(goblin.getProperty("hp"), 20);
 
+  // Test 7: Typed stats and string keys share the same slots
+  using entities::Prop;
+  goblin.set(Prop::Str, 4);
+  EXPECT_EQ(goblin.getProperty("str"), 4);
+  EXPECT_EQ(goblin.get(Prop::HP), 20);
+  EXPECT_TRUE(!goblin.has(Prop::Speed));
+  EXPECT_EQ(goblin.get(Prop::Speed, 100), 100);
+
+  // Test 8: Snapshot holds typed and dynamic keys
+  auto all = goblin.getAllProperties();
+  EXPECT_EQ(all.at("str"), 4);
+  EXPECT_EQ(all.at("damage"), 5);
+  EXPECT_EQ(all.count("speed"), 0u);
+
   std::cout << "Entity tests passed.\n";
   return EXIT_SUCCESS;
 }
@@ -83,11 +83,12 @@ void testPriorityOrdering() {
   EventQueue queue;
 
   // Push events in mixed priority order
-  queue.push(EntityMovedEvent{1, {0, 0}, {1, 1}}); // Normal priority
-  queue.push(
-      EntityDiedEvent{2, "goblin", {5, 5}, -1, "lava"}); // Immediate priority
-  queue.push(EntityDamagedEvent{3, 1, 50, 20, "physical"}); // High priority
-  queue.push(EntityMovedEvent{4, {2, 2}, {3, 3}});          // Normal priority
+  queue.push(EntityMovedEvent{EntityId{1, 0}, {0, 0}, {1, 1}}); // Normal
+  queue.push(EntityDiedEvent{EntityId{2, 0}, "goblin", {5, 5}, EntityId{},
+                             "lava"}); // Immediate priority
+  queue.push(EntityDamagedEvent{EntityId{3, 0}, EntityId{1, 0}, 50, 20,
+                                "physical"});                   // High
+  queue.push(EntityMovedEvent{EntityId{4, 0}, {2, 2}, {3, 3}}); // Normal
 
   std::vector<std::string> event_types;
 
@@ -165,9 +166,11 @@ void testEmptyQueueProcess() {
 void testGetPriority() {
   std::cout << "Testing getPriority function..." << std::endl;
 
-  Event died_event = EntityDiedEvent{1, "test", {0, 0}, -1, "fall"};
-  Event damaged_event = EntityDamagedEvent{2, 1, 10, 90, "physical"};
-  Event moved_event = EntityMovedEvent{3, {0, 0}, {1, 1}};
+  Event died_event =
+      EntityDiedEvent{EntityId{1, 0}, "test", {0, 0}, EntityId{}, "fall"};
+  Event damaged_event =
+      EntityDamagedEvent{EntityId{2, 0}, EntityId{1, 0}, 10, 90, "physical"};
+  Event moved_event = EntityMovedEvent{EntityId{3, 0}, {0, 0}, {1, 1}};
   Event transition_event =
       LevelTransitionEvent{LevelTransitionEvent::Down, 1, 2, {5, 5}};
 
@@ -187,10 +190,10 @@ void testEventDataIntegrity() {
 
   // Create complex event with all fields
   EntityDiedEvent died_evt{
-      123,               // entity_id
+      EntityId{123, 7},  // entity_id
       "Ancient Dragon",  // name
       Position{42, 17},  // position
-      456,               // killer_id
+      EntityId{456, 0},  // killer_id
       "heroic sacrifice" // cause_of_death
   };
 
@@ -200,11 +203,11 @@ void testEventDataIntegrity() {
     EXPECT_TRUE(std::holds_alternative<EntityDiedEvent>(e));
 
     const auto &evt = std::get<EntityDiedEvent>(e);
-    EXPECT_EQ(evt.entity_id, 123);
+    EXPECT_TRUE((evt.entity_id == EntityId{123, 7}));
     EXPECT_TRUE(evt.name == "Ancient Dragon");
     EXPECT_EQ(evt.position.x, 42);
     EXPECT_EQ(evt.position.y, 17);
-    EXPECT_EQ(evt.killer_id, 456);
+    EXPECT_TRUE((evt.killer_id == EntityId{456, 0}));
     EXPECT_TRUE(evt.cause_of_death == "heroic sacrifice");
   });
 
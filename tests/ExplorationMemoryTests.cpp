@@ -0,0 +1,84 @@
+#include "../src/core/BitGrid.hpp"
+#include "../src/core/FOV.hpp"
+#include "../src/world/ExplorationMemory.hpp"
+#include "../src/world/Map.hpp"
+#include "../src/world/MapViewAdapter.hpp"
+#include "include/assertions.hpp"
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+int main() {
+  using core::BitGrid;
+  using world::ExplorationMemory;
+
+  // Test 1: Merge reports only cells not seen before
+  ExplorationMemory memory(130, 4);
+  BitGrid visible(130, 4);
+  visible.set(1, 1);
+  visible.set(64, 2);
+  visible.set(129, 3);
+  EXPECT_EQ(memory.merge(visible), 3u);
+  EXPECT_TRUE(memory.isDiscovered(64, 2));
+  EXPECT_TRUE(!memory.isDiscovered(65, 2));
+  EXPECT_TRUE(!memory.isDiscovered(-1, 0));
+
+  visible.set(2, 1);
+  EXPECT_EQ(memory.merge(visible), 1u);
+  EXPECT_EQ(memory.count(), 4u);
+
+  // Test 2: Delta holds exactly the last merge's new cells
+  std::vector<core::Position> fresh;
+  memory.forEachNewlyDiscovered(
+      [&](int x, int y) { fresh.push_back({x, y}); });
+  EXPECT_EQ(fresh.size(), 1u);
+  EXPECT_EQ(fresh[0].x, 2);
+  EXPECT_EQ(fresh[0].y, 1);
+  EXPECT_EQ(memory.merge(visible), 0u);
+  EXPECT_EQ(memory.newlyDiscoveredCount(), 0u);
+
+  // Test 3: Rect merge only reads words covering the rectangle
+  BitGrid far(130, 4);
+  far.set(0, 0);
+  far.set(128, 0);
+  EXPECT_EQ(memory.merge(far, 100, 0, 129, 0), 1u);
+  EXPECT_TRUE(!memory.isDiscovered(0, 0));
+  EXPECT_TRUE(memory.isDiscovered(128, 0));
+
+  // Test 4: Region queries (minimap cells)
+  EXPECT_TRUE(memory.anyDiscoveredInRect(60, 0, 70, 3));
+  EXPECT_TRUE(!memory.anyDiscoveredInRect(3, 0, 63, 3));
+
+  // Test 5: Round trip through the LevelState vector<bool> form
+  const std::vector<bool> cells = memory.toVector();
+  EXPECT_EQ(cells.size(), 520u);
+  EXPECT_TRUE(cells[2 * 130 + 64]);
+  ExplorationMemory restored(130, 4);
+  restored.assign(cells);
+  EXPECT_EQ(restored.count(), memory.count());
+  EXPECT_TRUE(restored.isDiscovered(129, 3));
+  bool threw = false;
+  try {
+    restored.assign(std::vector<bool>(7));
+  } catch (const std::invalid_argument &) {
+    threw = true;
+  }
+  EXPECT_TRUE(threw);
+
+  // Test 6: mergeVisible() takes the FOV window
+  world::Map map(40, 20, world::Tile::OpenGround);
+  world::MapViewAdapter view(map);
+  core::FOV fov(view);
+  ExplorationMemory level(40, 20);
+  fov.compute({10, 10}, 3);
+  std::size_t visibleCells = 0;
+  fov.forEachVisible([&](int, int) { ++visibleCells; });
+  EXPECT_EQ(level.mergeVisible(fov), visibleCells);
+  fov.compute({11, 10}, 3);
+  EXPECT_EQ(level.mergeVisible(fov), 7u); // one new column
+  level.clear();
+  EXPECT_EQ(level.count(), 0u);
+
+  std::cout << "ExplorationMemory tests passed.\n";
+  return EXIT_SUCCESS;
+}
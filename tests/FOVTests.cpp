@@ -11,16 +11,16 @@ int main() {
   using world::Tile;
 
   // Pusta mapa (poza brzegami)
-  Map m(15, 11, Tile::Floor);
+  Map m(15, 11, Tile::OpenGround);
 
   // Obramowanie ścianami, żeby nie wyjść poza
   for (int x = 0; x < m.width(); ++x) {
-    m.set({x, 0}, Tile::Wall);
-    m.set({x, m.height() - 1}, Tile::Wall);
+    m.set({x, 0}, Tile::SolidRock);
+    m.set({x, m.height() - 1}, Tile::SolidRock);
   }
   for (int y = 0; y < m.height(); ++y) {
-    m.set({0, y}, Tile::Wall);
-    m.set({m.width() - 1, y}, Tile::Wall);
+    m.set({0, y}, Tile::SolidRock);
+    m.set({m.width() - 1, y}, Tile::SolidRock);
   }
 
   world::MapViewAdapter view(m);
@@ -43,12 +43,82 @@ int main() {
 #else
   // Budujemy pionową ścianę, która powinna przerywać LOS
   for (int y = 2; y <= 8; ++y)
-    m.set({10, y}, Tile::Wall);
+    m.set({10, y}, Tile::SolidRock);
   fov.compute(origin, radius);
   // Punkt za ścianą na tej samej linii poziomej
   EXPECT_TRUE(!fov.isVisible(12, 5));
+
+  // Oba algorytmy: ściana widoczna, to co za nią - nie
+  core::FOV rays(view, core::FOVAlgorithm::Bresenham);
+  rays.compute(origin, radius);
+  EXPECT_TRUE(rays.isVisible(10, 5));
+  EXPECT_TRUE(!rays.isVisible(12, 5));
+  EXPECT_TRUE(fov.isVisible(10, 5));
 #endif
 
+  // Shadowcasting jest symetryczny: A widzi B <=> B widzi A
+  Map pillars(15, 11, Tile::OpenGround);
+  pillars.set({5, 3}, Tile::SolidRock);
+  pillars.set({9, 6}, Tile::SolidRock);
+  pillars.set({6, 7}, Tile::SolidRock);
+  pillars.set({11, 4}, Tile::SolidRock);
+  world::MapViewAdapter pillarsView(pillars);
+  core::FOV a(pillarsView);
+  core::FOV b(pillarsView);
+  for (int ay = 0; ay < pillars.height(); ++ay)
+    for (int ax = 0; ax < pillars.width(); ++ax) {
+      if (pillars.isOpaque(ax, ay))
+        continue;
+      a.compute({ax, ay}, radius);
+      for (int by = 0; by < pillars.height(); ++by)
+        for (int bx = 0; bx < pillars.width(); ++bx) {
+          if (pillars.isOpaque(bx, by) || !a.isVisible(bx, by))
+            continue;
+          b.compute({bx, by}, radius);
+          EXPECT_TRUE(b.isVisible(ax, ay));
+        }
+    }
+
+  // Views instantiated on Map / raw opacity bits see exactly what the
+  // virtual IMapView path sees
+  core::BasicFOV<Map> direct(pillars);
+  core::OpacityBitsView bitsView(pillars.opaqueBits());
+  core::BasicFOV<core::OpacityBitsView> fromBits(bitsView);
+  for (const core::Position origin2 : {core::Position{7, 5}, {2, 2}, {12, 8}}) {
+    a.compute(origin2, radius);
+    direct.compute(origin2, radius);
+    fromBits.compute(origin2, radius);
+    for (int y = 0; y < pillars.height(); ++y)
+      for (int x = 0; x < pillars.width(); ++x) {
+        EXPECT_EQ(direct.isVisible(x, y), a.isVisible(x, y));
+        EXPECT_EQ(fromBits.isVisible(x, y), a.isVisible(x, y));
+      }
+  }
+
+  // Same origin and radius with no sight edit in the window: skipped.
+  // Edits outside the window do not invalidate, edits inside do.
+  Map open(40, 20, Tile::OpenGround);
+  world::MapViewAdapter openView(open);
+  core::FOV cached(openView);
+  core::Profiler::reset();
+  core::Profiler::setEnabled(true);
+  cached.compute({10, 10}, radius);
+  cached.compute({10, 10}, radius);
+  EXPECT_EQ(core::Profiler::calls(core::ProfileBucket::FOV), 1u);
+  open.set({30, 10}, Tile::SolidRock); // outside the radius window
+  cached.compute({10, 10}, radius);
+  EXPECT_EQ(core::Profiler::calls(core::ProfileBucket::FOV), 1u);
+  open.set({12, 10}, Tile::SolidRock); // inside: recomputed
+  cached.compute({10, 10}, radius);
+  EXPECT_EQ(core::Profiler::calls(core::ProfileBucket::FOV), 2u);
+  EXPECT_TRUE(!cached.isVisible(14, 10));
+  cached.compute({11, 10}, radius); // viewer moved
+  EXPECT_EQ(core::Profiler::calls(core::ProfileBucket::FOV), 3u);
+  cached.invalidate();
+  cached.compute({11, 10}, radius);
+  EXPECT_EQ(core::Profiler::calls(core::ProfileBucket::FOV), 4u);
+  core::Profiler::setEnabled(false);
+
   std::cout << "FOV tests passed.\n";
   return EXIT_SUCCESS;
 }
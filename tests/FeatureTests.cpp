@@ -1,6 +1,7 @@
 #include "../src/world/Feature.hpp"
 #include "../src/world/FeatureManager.hpp"
 #include "../src/world/FeatureProperties.hpp"
+#include "../src/world/Map.hpp"
 #include "assertions.hpp"
 #include <iostream>
 
@@ -327,6 +328,47 @@ void testDoorStateTransitions() {
   std::cout << "  ✓ Door state transitions work correctly" << std::endl;
 }
 
+// Test map bit layers following an attached manager
+void testFeatureManagerMapLayers() {
+  std::cout << "Testing map feature layers..." << std::endl;
+
+  Map map(20, 10, Tile::OpenGround);
+  FeatureManager manager;
+  Position door_pos{5, 5};
+
+  // Features added before attach are picked up by attach()
+  manager.addFeature(door_pos, Door{Door::Material::Wood, Door::State::Closed});
+  EXPECT_TRUE(map.isPassable(5, 5));
+  manager.attach(&map);
+  EXPECT_FALSE(map.isPassable(5, 5));
+  EXPECT_TRUE(map.blocksSight(5, 5));
+  EXPECT_TRUE(map.isWalkable(5, 5)); // tile layer unaffected
+
+  // Door state changes go through setDoorState
+  EXPECT_TRUE(manager.setDoorState(door_pos, Door::State::Open));
+  EXPECT_TRUE(map.isPassable(5, 5));
+  EXPECT_FALSE(map.blocksSight(5, 5));
+  EXPECT_FALSE(manager.setDoorState({1, 1}, Door::State::Open));
+
+  manager.setDoorState(door_pos, Door::State::Closed);
+  manager.removeFeature(door_pos);
+  EXPECT_TRUE(map.isPassable(5, 5));
+
+  // Tile layers follow Map::set
+  map.set({3, 3}, Tile::SolidRock);
+  EXPECT_FALSE(map.isWalkable(3, 3));
+  EXPECT_TRUE(map.isOpaque(3, 3));
+  EXPECT_EQ(map.featureBlockedBits().count(), 0u);
+
+  // Detaching clears the feature layers
+  manager.addFeature(door_pos, Door{Door::Material::Iron, Door::State::Closed});
+  EXPECT_FALSE(map.isPassable(5, 5));
+  manager.attach(nullptr);
+  EXPECT_TRUE(map.isPassable(5, 5));
+
+  std::cout << "  ✓ Map layers track features" << std::endl;
+}
+
 int main() {
   std::cout << "\n=== Feature System Tests ===" << std::endl;
 
@@ -354,6 +396,7 @@ int main() {
 
     // Integration test
     testDoorStateTransitions();
+    testFeatureManagerMapLayers();
 
     std::cout << "\n✓ All tests passed!" << std::endl;
     return 0;
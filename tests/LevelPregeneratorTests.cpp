@@ -0,0 +1,95 @@
+#include "../src/core/ThreadPool.hpp"
+#include "../src/world/gen/LevelPregenerator.hpp"
+#include "include/assertions.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+bool sameTiles(const world::Map &a, const world::Map &b) {
+  if (a.width() != b.width() || a.height() != b.height())
+    return false;
+  for (int y = 0; y < a.height(); ++y)
+    for (int x = 0; x < a.width(); ++x)
+      if (a.at({x, y}) != b.at({x, y}))
+        return false;
+  return true;
+}
+
+} // namespace
+
+int main() {
+  constexpr std::uint64_t SEED = 42;
+  constexpr int W = 60, H = 40;
+  const config::LevelConfig cfg = config::largeDungeon();
+
+  // Test 1: Pool runs every task and returns results through futures
+  {
+    core::ThreadPool pool(3);
+    EXPECT_EQ(pool.size(), 3u);
+    std::atomic<int> sum{0};
+    std::vector<std::future<int>> results;
+    for (int i = 1; i <= 100; ++i)
+      results.push_back(pool.submit([i, &sum] {
+        sum += i;
+        return i * 2;
+      }));
+    int doubled = 0;
+    for (auto &r : results)
+      doubled += r.get();
+    EXPECT_EQ(doubled, 10100);
+    EXPECT_EQ(sum.load(), 5050);
+  }
+
+  // Test 2: Per-depth generators differ and are stable
+  EXPECT_TRUE(world::LevelPregenerator::rngForDepth(SEED, 1)() !=
+              world::LevelPregenerator::rngForDepth(SEED, 2)());
+  EXPECT_TRUE(world::LevelPregenerator::rngForDepth(SEED, 3)() ==
+              world::LevelPregenerator::rngForDepth(SEED, 3)());
+
+  core::ThreadPool pool(2);
+
+  // Test 3: Background level equals the synchronously generated one
+  {
+    world::LevelPregenerator pregen(pool, SEED, W, H, cfg, 2);
+    world::LevelData first = pregen.take(1);
+    EXPECT_EQ(pregen.pending(), 2u); // depths 2 and 3 queued
+    world::LevelData second = pregen.take(2);
+    const world::LevelData reference =
+        world::LevelPregenerator::generate(SEED, W, H, 2, cfg);
+    EXPECT_TRUE(second.map != nullptr);
+    EXPECT_EQ(second.depth, 2);
+    EXPECT_TRUE(sameTiles(*second.map, *reference.map));
+    EXPECT_TRUE(second.player_spawn == reference.player_spawn);
+    EXPECT_TRUE(!sameTiles(*first.map, *second.map));
+  }
+
+  // Test 4: Cancelled depth is regenerated on demand, identically
+  {
+    world::LevelPregenerator pregen(pool, SEED, W, H, cfg, 0);
+    pregen.request(5);
+    pregen.cancel(5);
+    EXPECT_EQ(pregen.pending(), 0u);
+    world::LevelData level = pregen.take(5);
+    const world::LevelData reference =
+        world::LevelPregenerator::generate(SEED, W, H, 5, cfg);
+    EXPECT_TRUE(level.map != nullptr);
+    EXPECT_TRUE(sameTiles(*level.map, *reference.map));
+  }
+
+  // Test 5: Taking a deeper level drops speculation for shallower ones
+  {
+    world::LevelPregenerator pregen(pool, SEED, W, H, cfg, 1);
+    pregen.request(2);
+    pregen.request(3);
+    world::LevelData level = pregen.take(4);
+    EXPECT_EQ(level.depth, 4);
+    EXPECT_EQ(pregen.pending(), 1u); // only depth 5
+  }
+
+  std::cout << "LevelPregenerator tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -4,6 +4,7 @@
 #include "../src/world/MapViewAdapter.hpp"
 #include "../src/world/Tile.hpp"
 #include "include/assertions.hpp"
+#include <cstdlib>
 #include <iostream>
 
 int main() {
@@ -13,16 +14,16 @@ int main() {
   using core::Pathfinding;
 
   // Create simple test map
-  Map m(10, 10, Tile::Floor);
+  Map m(10, 10, Tile::OpenGround);
 
   // Add walls around edges
   for (int x = 0; x < m.width(); ++x) {
-    m.set({x, 0}, Tile::Wall);
-    m.set({x, m.height() - 1}, Tile::Wall);
+    m.set({x, 0}, Tile::SolidRock);
+    m.set({x, m.height() - 1}, Tile::SolidRock);
   }
   for (int y = 0; y < m.height(); ++y) {
-    m.set({0, y}, Tile::Wall);
-    m.set({m.width() - 1, y}, Tile::Wall);
+    m.set({0, y}, Tile::SolidRock);
+    m.set({m.width() - 1, y}, Tile::SolidRock);
   }
 
   MapViewAdapter view(m);
@@ -37,15 +38,15 @@ int main() {
   EXPECT_EQ(path1.back().y, 1);
 
   // Test 2: Path with obstacle
-  m.set({5, 5}, Tile::Wall);
-  m.set({5, 6}, Tile::Wall);
-  m.set({5, 4}, Tile::Wall);
+  m.set({5, 5}, Tile::SolidRock);
+  m.set({5, 6}, Tile::SolidRock);
+  m.set({5, 4}, Tile::SolidRock);
   auto path2 = pathfinder.findPath({3, 5}, {7, 5});
   EXPECT_TRUE(!path2.empty());
 
   // Test 3: No path available (completely blocked)
   for (int y = 1; y < 9; ++y)
-    m.set({5, y}, Tile::Wall);
+    m.set({5, y}, Tile::SolidRock);
   auto path3 = pathfinder.findPath({1, 1}, {8, 8});
   EXPECT_TRUE(path3.empty());
 
@@ -54,6 +55,41 @@ int main() {
   EXPECT_TRUE(!path4.empty());
   EXPECT_EQ(path4.size(), 1);
 
+  // Test 5: Node arrays are reused - repeated queries stay consistent
+  for (int y = 1; y < 9; ++y)
+    m.set({5, y}, Tile::OpenGround);
+  auto first = pathfinder.findPath({1, 1}, {8, 8});
+  EXPECT_TRUE(!first.empty());
+  for (int i = 0; i < 100; ++i) {
+    auto again = pathfinder.findPath({1, 1}, {8, 8});
+    EXPECT_EQ(again.size(), first.size());
+    auto back = pathfinder.findPath({8, 8}, {1, 1});
+    EXPECT_TRUE(!back.empty());
+  }
+
+  // Test 6: Every step is adjacent and walkable
+  for (size_t i = 1; i < first.size(); ++i) {
+    EXPECT_TRUE(std::abs(first[i].x - first[i - 1].x) <= 1);
+    EXPECT_TRUE(std::abs(first[i].y - first[i - 1].y) <= 1);
+    EXPECT_TRUE(!m.isOpaque(first[i].x, first[i].y));
+  }
+
+  // Test 7: Goal outside of map
+  EXPECT_TRUE(pathfinder.findPath({1, 1}, {20, 20}).empty());
+
+  // Test 8: Map and raw opacity bits as direct views give the same paths
+  m.set({5, 3}, Tile::SolidRock);
+  m.set({4, 6}, Tile::SolidRock);
+  core::BasicPathfinding<Map> direct(m);
+  core::OpacityBitsView bitsView(m.opaqueBits());
+  core::BasicPathfinding<core::OpacityBitsView> fromBits(bitsView);
+  const auto virtualPath = pathfinder.findPath({1, 1}, {8, 8});
+  const auto directPath = direct.findPath({1, 1}, {8, 8});
+  EXPECT_EQ(directPath.size(), virtualPath.size());
+  EXPECT_EQ(fromBits.findPath({1, 1}, {8, 8}).size(), virtualPath.size());
+  for (size_t i = 0; i < directPath.size(); ++i)
+    EXPECT_TRUE(directPath[i] == virtualPath[i]);
+
   std::cout << "Pathfinding tests passed.\n";
   return EXIT_SUCCESS;
 }
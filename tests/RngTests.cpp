@@ -0,0 +1,88 @@
+#include "../src/core/Rng.hpp"
+#include "include/assertions.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+int main() {
+  using core::Rng;
+
+  // Test 1: Philox4x32-10 known-answer vectors (Random123)
+  const Rng::Block zero = Rng::philox({0, 0, 0, 0}, 0);
+  EXPECT_EQ(zero[0], 0x6627e8d5u);
+  EXPECT_EQ(zero[1], 0xe169c58du);
+  EXPECT_EQ(zero[2], 0xbc57ac4cu);
+  EXPECT_EQ(zero[3], 0x9b00dbd8u);
+  const Rng::Block pi = Rng::philox(
+      {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u},
+      (std::uint64_t{0x299f31d0u} << 32) | 0xa4093822u);
+  EXPECT_EQ(pi[0], 0xd16cfe09u);
+  EXPECT_EQ(pi[1], 0x94fdccebu);
+  EXPECT_EQ(pi[2], 0x5001e420u);
+  EXPECT_EQ(pi[3], 0x24126ea1u);
+
+  // Test 2: Same seed, same sequence; different seed, different sequence
+  Rng a(7), b(7), c(8);
+  bool differs = false;
+  for (int i = 0; i < 100; ++i) {
+    const auto va = a();
+    EXPECT_EQ(va, b());
+    differs = differs || va != c();
+  }
+  EXPECT_TRUE(differs);
+
+  // Test 3: fork/stream depend only on the key, not on draws made so far
+  Rng parent(99);
+  const Rng early = parent.fork("terrain");
+  for (int i = 0; i < 37; ++i)
+    parent();
+  Rng late = parent.fork("terrain");
+  Rng earlyCopy = early;
+  EXPECT_EQ(earlyCopy(), late());
+  EXPECT_TRUE(Rng(99).fork("terrain")() != Rng(99).fork("features")());
+  EXPECT_TRUE(Rng(99).stream(1)() != Rng(99).stream(2)());
+  EXPECT_TRUE(Rng(99).stream(1)() == Rng(99).stream(1)());
+
+  // Test 4: discard(n) lands where n draws would (odd and even offsets)
+  for (std::uint64_t skip : {0u, 1u, 2u, 5u, 64u}) {
+    Rng drawn(3), skipped(3);
+    drawn();
+    skipped();
+    for (std::uint64_t i = 0; i < skip; ++i)
+      drawn();
+    skipped.discard(skip);
+    EXPECT_EQ(drawn(), skipped());
+    EXPECT_EQ(drawn(), skipped());
+  }
+
+  // Test 5: uniformInt stays in range and hits every value
+  Rng r(5);
+  std::array<int, 7> hits{};
+  for (int i = 0; i < 7000; ++i) {
+    const int v = r.uniformInt(-3, 3);
+    EXPECT_TRUE(v >= -3 && v <= 3);
+    ++hits[static_cast<std::size_t>(v + 3)];
+  }
+  for (int h : hits)
+    EXPECT_TRUE(h > 800 && h < 1200);
+  EXPECT_EQ(r.uniformInt(4, 4), 4);
+
+  // Test 6: uniformReal in [0, 1), shuffle is a permutation
+  for (int i = 0; i < 1000; ++i) {
+    const double d = r.uniformReal();
+    EXPECT_TRUE(d >= 0.0 && d < 1.0);
+  }
+  std::vector<int> perm(50);
+  std::iota(perm.begin(), perm.end(), 0);
+  r.shuffle(perm.begin(), perm.end());
+  EXPECT_TRUE(!std::is_sorted(perm.begin(), perm.end()));
+  std::sort(perm.begin(), perm.end());
+  for (int i = 0; i < 50; ++i)
+    EXPECT_EQ(perm[static_cast<std::size_t>(i)], i);
+
+  std::cout << "Rng tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+#include "../src/serialization/SaveArchive.hpp"
+#include "include/assertions.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+serialization::LevelState makeLevel(int depth) {
+  world::Map map(30, 20, world::Tile::SolidRock);
+  for (int x = 1; x < 29; ++x)
+    map.set({x, depth % 20}, world::Tile::OpenGround);
+
+  world::FeatureManager features;
+  features.addFeature({2, depth % 20},
+                      world::Stairs{world::Stairs::Direction::Down, depth + 1});
+  features.addFeature({4, depth % 20},
+                      world::Door{world::Door::Material::Wood,
+                                  world::Door::State::Closed});
+
+  entities::EntityManager entities;
+  entities.createEntity("Rat", core::Position{3, 1}).setProperty("hp", depth);
+
+  std::vector<bool> discovered(30 * 20, false);
+  discovered[static_cast<std::size_t>(depth)] = true;
+  return serialization::LevelState(std::move(map), std::move(features),
+                                   std::move(entities), std::move(discovered),
+                                   depth);
+}
+
+} // namespace
+
+int main() {
+  using serialization::SaveArchive;
+  const std::string filename = "test_archive.sav";
+
+  serialization::SaveData data;
+  data.turn_counter = 900;
+  data.current_level_index = 2;
+  for (int depth = 1; depth <= 4; ++depth)
+    data.visited_levels.push_back(makeLevel(depth));
+  serialization::saveGame(data, filename);
+
+  // Test 1: Opening reads only the index
+  {
+    SaveArchive archive(filename);
+    EXPECT_EQ(archive.turnCounter(), 900);
+    EXPECT_EQ(archive.currentLevelIndex(), 2);
+    EXPECT_EQ(archive.levelCount(), 4u);
+    EXPECT_EQ(archive.levelDepth(3), 4);
+    EXPECT_TRUE(archive.findDepth(2) == std::optional<std::size_t>(1));
+    EXPECT_TRUE(!archive.findDepth(9).has_value());
+
+    // Test 2: Levels decode on demand
+    serialization::LevelState current = archive.loadCurrentLevel();
+    EXPECT_EQ(current.depth, 3);
+    EXPECT_TRUE(current.map.at({5, 3}) == world::Tile::OpenGround);
+    EXPECT_TRUE(current.discovered[3]);
+    EXPECT_EQ(current.entities.getEntities()[0]->getProperty("hp"), 3);
+    // Features come back bound: the closed door blocks sight and movement
+    EXPECT_TRUE(current.features.attachedMap() == &current.map);
+    EXPECT_TRUE(current.map.blocksSight(4, 3));
+    EXPECT_TRUE(!current.map.isPassable(4, 3));
+
+    serialization::LevelState first = archive.loadLevel(0);
+    EXPECT_EQ(first.depth, 1);
+    EXPECT_EQ(first.features.size(), 2u);
+
+    // Test 3: Move keeps the mapping usable
+    SaveArchive moved(std::move(archive));
+    EXPECT_EQ(moved.loadLevel(3).depth, 4);
+    EXPECT_EQ(moved.loadAll().visited_levels.size(), 4u);
+  }
+
+  // Test 4: A broken level only fails when it is loaded
+  {
+    std::ifstream in(filename, std::ios::binary);
+    const std::vector<std::uint8_t> bytes{std::istreambuf_iterator<char>(in),
+                                          std::istreambuf_iterator<char>()};
+    in.close();
+    const serialization::BinaryIndex index =
+        serialization::readBinaryIndex(bytes);
+    std::fstream file(filename,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    const auto &level = index.levels[0];
+    // Overwrite level 0's block with varints that never terminate
+    file.seekp(level.offset);
+    for (std::uint32_t i = 0; i < level.size; ++i)
+      file.put(static_cast<char>(0xFF));
+    file.close();
+
+    SaveArchive archive(filename);
+    EXPECT_EQ(archive.loadLevel(1).depth, 2);
+    bool threw = false;
+    try {
+      archive.loadLevel(0);
+    } catch (const std::runtime_error &) {
+      threw = true;
+    }
+    EXPECT_TRUE(threw);
+  }
+
+  // Test 5: JSON exports are not archives
+  serialization::saveGame(data, filename, serialization::SaveFormat::Json);
+  bool rejected = false;
+  try {
+    SaveArchive archive(filename);
+  } catch (const std::runtime_error &) {
+    rejected = true;
+  }
+  EXPECT_TRUE(rejected);
+
+  std::remove(filename.c_str());
+  std::cout << "SaveArchive tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,221 @@
+#include "../src/serialization/AutosaveService.hpp"
+#include "../src/serialization/DeltaTracker.hpp"
+#include "../src/serialization/SaveArchive.hpp"
+#include "../src/serialization/SaveJournal.hpp"
+#include "../src/world/ExplorationMemory.hpp"
+#include "include/assertions.hpp"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <variant>
+
+namespace {
+
+using serialization::DeltaTracker;
+using serialization::JournalRecord;
+
+const world::Door CLOSED{world::Door::Material::Wood,
+                         world::Door::State::Closed};
+
+// Same tiles, discovered cells, features and entities (by position)
+bool sameLevel(const serialization::LevelState &loaded, const world::Map &map,
+               const world::FeatureManager &features,
+               const entities::EntityManager &entities,
+               const world::ExplorationMemory &exploration) {
+  for (int y = 0; y < map.height(); ++y) {
+    for (int x = 0; x < map.width(); ++x) {
+      const std::size_t cell = static_cast<std::size_t>(y * map.width() + x);
+      if (loaded.map.at({x, y}) != map.at({x, y}) ||
+          loaded.discovered[cell] != exploration.isDiscovered(x, y))
+        return false;
+    }
+  }
+  if (loaded.features.size() != features.size())
+    return false;
+  for (const auto &pos : features.getAllPositions()) {
+    const auto *door = std::get_if<world::Door>(features.getFeature(pos));
+    const auto *other = loaded.features.getFeature(pos);
+    if (!other || (door && std::get<world::Door>(*other).state != door->state))
+      return false;
+  }
+  if (loaded.entities.count() != entities.count())
+    return false;
+  for (const auto &e : entities.getEntities()) {
+    const entities::Entity *twin =
+        loaded.entities.getEntityAt(e->getPosition());
+    if (!twin || twin->getName() != e->getName() ||
+        twin->get(entities::Prop::HP) != e->get(entities::Prop::HP) ||
+        twin->hasAI() != e->hasAI())
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+int main() {
+  const std::string filename = "test_journal.sav";
+
+  world::Map map(40, 20, world::Tile::OpenGround);
+  world::FeatureManager features;
+  features.addFeature({5, 5}, CLOSED);
+  features.addFeature({9, 2}, CLOSED);
+  entities::EntityManager entities(40, 20);
+  entities::Entity *playerPtr =
+      &entities.createEntity("Player", core::Position{1, 1});
+  playerPtr->setHP(50);
+  const core::EntityId goblin =
+      entities.createEntity("Goblin", core::Position{10, 10}).getId();
+  world::ExplorationMemory exploration(40, 20);
+  exploration.discover(1, 1);
+
+  // Test 1: Records survive encoding, in order
+  {
+    JournalRecord record;
+    record.turn_counter = 12;
+    record.depth = 2;
+    record.tiles = {{3, world::Tile::SolidRock}, {700, world::Tile::OpenGround}};
+    record.discovered = {9, 8, 400};
+    record.features = {{{5, 5}, CLOSED}, {{9, 2}, std::nullopt}};
+    record.removedEntities = {1};
+    serialization::EntitySnapshot snap;
+    snap.name = "Rat";
+    snap.position = {-2, 7};
+    snap.properties = {{"HP", 3}, {"custom", -9}};
+    snap.hasAI = true;
+    record.entities = {{4, snap}};
+
+    auto bytes = serialization::encodeJournalHeader(77);
+    for (int i = 0; i < 2; ++i) {
+      const auto framed = serialization::encodeJournalRecord(record);
+      bytes.insert(bytes.end(), framed.begin(), framed.end());
+    }
+    const auto records = serialization::readJournal(bytes, 77);
+    EXPECT_EQ(records.size(), 2u);
+    EXPECT_EQ(records[1].turn_counter, 12);
+    EXPECT_TRUE(records[1].tiles == record.tiles);
+    EXPECT_TRUE(records[1].discovered == record.discovered);
+    EXPECT_EQ(records[1].features.size(), 2u);
+    EXPECT_TRUE(!records[1].features[1].second.has_value());
+    EXPECT_TRUE(records[1].removedEntities == record.removedEntities);
+    EXPECT_TRUE(records[1].entities[0].second == snap);
+
+    // Another base's journal is ignored
+    EXPECT_TRUE(serialization::readJournal(bytes, 78).empty());
+
+    // A torn tail drops only the last record
+    bytes.resize(bytes.size() - 3);
+    EXPECT_EQ(serialization::readJournal(bytes, 77).size(), 1u);
+    bytes[bytes.size() - 1] ^= 0xFF;
+    EXPECT_EQ(serialization::readJournal(bytes, 77).size(), 1u);
+  }
+
+  // Test 2: The tracker journals only what changed
+  {
+    DeltaTracker tracker;
+    auto first =
+        tracker.capture(map, features, entities, exploration.bits(), 2, 1);
+    EXPECT_TRUE(std::holds_alternative<serialization::SaveSnapshot>(first));
+    EXPECT_TRUE(std::get<serialization::SaveSnapshot>(first).save_id != 0);
+
+    auto idle =
+        tracker.capture(map, features, entities, exploration.bits(), 2, 2);
+    EXPECT_TRUE(std::holds_alternative<JournalRecord>(idle));
+    EXPECT_TRUE(std::get<JournalRecord>(idle).empty());
+
+    features.setDoorState({5, 5}, world::Door::State::Open);
+    playerPtr->setPosition({2, 1});
+    map.set({3, 3}, world::Tile::SolidRock);
+    exploration.discover(2, 1);
+    auto delta =
+        tracker.capture(map, features, entities, exploration.bits(), 2, 3);
+    const JournalRecord &record = std::get<JournalRecord>(delta);
+    EXPECT_EQ(record.tiles.size(), 1u);
+    EXPECT_EQ(record.tiles[0].first, 3u * 40u + 3u);
+    EXPECT_EQ(record.discovered.size(), 1u);
+    EXPECT_EQ(record.features.size(), 1u);
+    EXPECT_EQ(record.entities.size(), 1u); // the goblin did not change
+    EXPECT_EQ(record.entities[0].first, 0u);
+    EXPECT_TRUE(record.removedEntities.empty());
+    EXPECT_EQ(tracker.recordsSinceBase(), 2u);
+
+    // Forgetting cells cannot be journaled
+    exploration.clear();
+    auto full =
+        tracker.capture(map, features, entities, exploration.bits(), 2, 4);
+    EXPECT_TRUE(std::holds_alternative<serialization::SaveSnapshot>(full));
+    exploration.discover(1, 1);
+  }
+
+  // Test 3: Base + journal reload to the live level
+  {
+    serialization::AutosaveService service(
+        filename, serialization::FsyncPolicy::None, 8);
+    EXPECT_TRUE(service.submitLevel(map, features, entities,
+                                    exploration.bits(), 2, 10));
+    service.wait();
+
+    features.removeFeature({9, 2});
+    entities.removeEntity(goblin);
+    entities.createEntity("Rat", core::Position{20, 5}).setHP(4);
+    EXPECT_TRUE(service.submitLevel(map, features, entities,
+                                    exploration.bits(), 2, 11));
+    service.wait();
+
+    playerPtr->setHP(31);
+    map.set({6, 6}, world::Tile::SolidRock);
+    exploration.discover(30, 15);
+    EXPECT_TRUE(service.submitLevel(map, features, entities,
+                                    exploration.bits(), 2, 12));
+    service.wait();
+    EXPECT_EQ(service.compactions(), 1u);
+    EXPECT_EQ(service.journaled(), 2u);
+    EXPECT_EQ(service.failed(), 0u);
+
+    serialization::SaveData loaded = serialization::loadGame(filename);
+    EXPECT_EQ(loaded.turn_counter, 12);
+    EXPECT_TRUE(sameLevel(loaded.visited_levels[0], map, features, entities,
+                          exploration));
+
+    serialization::SaveArchive archive(filename);
+    EXPECT_EQ(archive.turnCounter(), 12);
+    EXPECT_TRUE(sameLevel(archive.loadLevel(0), map, features, entities,
+                          exploration));
+  }
+
+  // Test 4: Compaction every compactEvery saves
+  {
+    serialization::AutosaveService service(
+        filename, serialization::FsyncPolicy::None, 2);
+    for (int turn = 20; turn < 25; ++turn) {
+      playerPtr->setPosition({1 + turn % 2, 1});
+      EXPECT_TRUE(service.submitLevel(map, features, entities,
+                                      exploration.bits(), 2, turn));
+      service.wait();
+    }
+    EXPECT_EQ(service.compactions(), 2u); // turns 20 and 23
+    EXPECT_EQ(service.journaled(), 3u);
+    EXPECT_TRUE(sameLevel(serialization::loadGame(filename).visited_levels[0],
+                          map, features, entities, exploration));
+  }
+
+  // Test 5: A plain save replaces the base; the old journal goes stale
+  {
+    serialization::SaveData data;
+    data.turn_counter = 99;
+    data.visited_levels.emplace_back(world::Map(8, 8, world::Tile::OpenGround),
+                                     world::FeatureManager{},
+                                     entities::EntityManager{},
+                                     std::vector<bool>(64), 2);
+    serialization::saveGame(data, filename);
+    const serialization::SaveData loaded = serialization::loadGame(filename);
+    EXPECT_EQ(loaded.turn_counter, 99);
+    EXPECT_EQ(loaded.visited_levels[0].entities.count(), 0u);
+  }
+
+  std::remove(filename.c_str());
+  std::remove(serialization::journalFilename(filename).c_str());
+  std::cout << "SaveJournal tests passed.\n";
+  return EXIT_SUCCESS;
+}
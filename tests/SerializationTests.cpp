@@ -1,6 +1,9 @@
 #include "../src/ai/SimpleAI.hpp"
 #include "../src/core/Serialization.hpp"
-#include "../src/serialization/GameSerialization.hpp"
+#include "../src/serialization/BinarySave.hpp"
+#include "../src/serialization/ByteIO.hpp"
+#include "../src/serialization/Gameserialization.hpp"
+#include "../src/serialization/JsonSaveReader.hpp"
 #include "../src/world/FeatureProperties.hpp" // ADD THIS - for getDoor, getStairs, etc
 #include "assertions.hpp"
 #include <fstream>
@@ -184,16 +187,14 @@ void testEntityManagerSerialization() {
 
   EntityManager original;
 
-  auto e1 = std::make_unique<Entity>("Player", Position{5, 5});
-  e1->setGlyph('@');
-  e1->setProperty("hp", 100);
-  original.addEntity(std::move(e1));
+  Entity &e1 = original.createEntity("Player", Position{5, 5});
+  e1.setGlyph('@');
+  e1.setProperty("hp", 100);
 
-  auto e2 = std::make_unique<Entity>("Goblin", Position{10, 10});
-  e2->setGlyph('g');
-  e2->setProperty("hp", 20);
-  e2->setAI(std::make_unique<ai::SimpleAI>());
-  original.addEntity(std::move(e2));
+  Entity &e2 = original.createEntity("Goblin", Position{10, 10});
+  e2.setGlyph('g');
+  e2.setProperty("hp", 20);
+  e2.setAI(std::make_unique<ai::SimpleAI>());
 
   json j;
   entities::to_json(j, original); // Explicit call
@@ -230,8 +231,7 @@ void testLevelStateSerialization() {
                       Door{Door::Material::Wood, Door::State::Closed});
 
   EntityManager entities_mgr;
-  auto entity = std::make_unique<Entity>("Test", Position{3, 3});
-  entities_mgr.addEntity(std::move(entity));
+  entities_mgr.createEntity("Test", Position{3, 3});
 
   std::vector<bool> discovered(20 * 15, false);
   discovered[0] = true; // Mark first tile as discovered
@@ -334,9 +334,7 @@ void testSaveLoadFile() {
   features.addFeature({4, 4}, Stairs{Stairs::Direction::Down, 2});
 
   EntityManager entities;
-  auto entity = std::make_unique<Entity>("Hero", Position{1, 1});
-  entity->setProperty("hp", 75);
-  entities.addEntity(std::move(entity));
+  entities.createEntity("Hero", Position{1, 1}).setProperty("hp", 75);
 
   std::vector<bool> discovered(48, false);
   discovered[0] = true;
@@ -373,6 +371,366 @@ void testSaveLoadFile() {
   std::cout << "  ✓ Save/load file successful" << std::endl;
 }
 
+// Level with a bit of everything, for the binary format tests
+LevelState makeBinaryTestLevel(int depth) {
+  Map map(40, 25, Tile::SolidRock);
+  for (int y = 5; y < 20; ++y)
+    for (int x = 5; x < 35; ++x)
+      map.set({x, y}, Tile::OpenGround);
+  map.set({39, 24}, Tile::DeepLiquid); // run ending on the last cell
+
+  FeatureManager features;
+  features.addFeature({5, 10}, Door{Door::Material::Iron, Door::State::Closed});
+  features.addFeature({20, 12}, Stairs{Stairs::Direction::Up, depth - 1});
+
+  EntityManager entities_mgr;
+  for (int i = 0; i < 3; ++i) {
+    Entity &goblin = entities_mgr.createEntity("Goblin", Position{10 + i, 8});
+    goblin.setGlyph('g');
+    goblin.setProperty("hp", 7 - i);
+    goblin.setProperty("custom_key", -i); // not a Prop slot
+    goblin.setAI(std::make_unique<ai::SimpleAI>());
+  }
+
+  std::vector<bool> discovered(40 * 25, false);
+  for (std::size_t i = 0; i < discovered.size(); i += 3)
+    discovered[i] = true;
+
+  return LevelState(std::move(map), std::move(features),
+                    std::move(entities_mgr), std::move(discovered), depth);
+}
+
+// Test binary encode/decode round trip
+void testBinaryRoundTrip() {
+  std::cout << "Testing binary SaveData round trip..." << std::endl;
+
+  SaveData original;
+  original.turn_counter = 123456;
+  original.current_level_index = 1;
+  original.visited_levels.push_back(makeBinaryTestLevel(1));
+  original.visited_levels.push_back(makeBinaryTestLevel(2));
+
+  const std::vector<std::uint8_t> bytes = encodeBinary(original);
+  EXPECT_TRUE(isBinarySave(bytes));
+  SaveData restored = decodeBinary(bytes);
+
+  EXPECT_EQ(restored.turn_counter, 123456);
+  EXPECT_EQ(restored.current_level_index, 1);
+  EXPECT_EQ(restored.visited_levels.size(), 2u);
+  for (std::size_t l = 0; l < 2; ++l) {
+    const LevelState &a = original.visited_levels[l];
+    const LevelState &b = restored.visited_levels[l];
+    EXPECT_EQ(b.depth, a.depth);
+    EXPECT_EQ(b.map.width(), a.map.width());
+    EXPECT_EQ(b.map.height(), a.map.height());
+    for (int y = 0; y < a.map.height(); ++y)
+      for (int x = 0; x < a.map.width(); ++x)
+        EXPECT_TRUE(b.map.at({x, y}) == a.map.at({x, y}));
+    EXPECT_EQ(b.map.tileRevision(), 0u); // adopted, not set() per cell
+    EXPECT_TRUE(b.discovered == a.discovered);
+
+    EXPECT_EQ(b.features.size(), 2u);
+    const Door *door = getDoor(*b.features.getFeature({5, 10}));
+    EXPECT_TRUE(door != nullptr);
+    EXPECT_TRUE(door->material == Door::Material::Iron);
+    EXPECT_TRUE(door->state == Door::State::Closed);
+    const Stairs *stairs = getStairs(*b.features.getFeature({20, 12}));
+    EXPECT_TRUE(stairs != nullptr);
+    EXPECT_EQ(stairs->target_depth, a.depth - 1);
+
+    EXPECT_EQ(b.entities.getEntities().size(), 3u);
+    Entity *goblin = b.entities.getEntityAt({12, 8});
+    EXPECT_TRUE(goblin != nullptr);
+    EXPECT_TRUE(goblin->getName() == "Goblin");
+    EXPECT_EQ(goblin->getGlyph(), 'g');
+    EXPECT_EQ(goblin->getProperty("hp"), 5);
+    EXPECT_EQ(goblin->getProperty("custom_key"), -2);
+    EXPECT_TRUE(goblin->hasAI());
+  }
+
+  std::cout << "  ✓ Binary round trip successful" << std::endl;
+}
+
+// Test binary output is much smaller than the JSON export
+void testBinarySize() {
+  std::cout << "Testing binary save size..." << std::endl;
+
+  SaveData data;
+  for (int depth = 1; depth <= 4; ++depth)
+    data.visited_levels.push_back(makeBinaryTestLevel(depth));
+
+  json j;
+  serialization::to_json(j, data);
+  const std::size_t jsonSize = j.dump(2).size();
+  const std::size_t binarySize = encodeBinary(data).size();
+  std::cout << "  JSON " << jsonSize << " bytes, binary " << binarySize
+            << " bytes" << std::endl;
+  EXPECT_TRUE(binarySize * 10 < jsonSize);
+
+  std::cout << "  ✓ Binary save is compact" << std::endl;
+}
+
+// Test loadGame() detects both formats
+void testLoadDetectsFormat() {
+  std::cout << "Testing save format detection..." << std::endl;
+
+  SaveData original;
+  original.turn_counter = 42;
+  original.visited_levels.push_back(makeBinaryTestLevel(3));
+
+  const std::string binaryFile = "test_save.bin";
+  const std::string jsonFile = "test_save_debug.json";
+  saveGame(original, binaryFile);
+  saveGame(original, jsonFile, SaveFormat::Json);
+
+  {
+    std::ifstream check(jsonFile);
+    EXPECT_EQ(check.get(), '{');
+  }
+
+  SaveData fromBinary = loadGame(binaryFile);
+  SaveData fromJson = loadGame(jsonFile);
+  EXPECT_EQ(fromBinary.turn_counter, 42);
+  EXPECT_EQ(fromJson.turn_counter, 42);
+  EXPECT_TRUE(fromBinary.visited_levels[0].discovered ==
+              fromJson.visited_levels[0].discovered);
+  EXPECT_EQ(fromBinary.visited_levels[0].entities.getEntities().size(),
+            fromJson.visited_levels[0].entities.getEntities().size());
+
+  std::remove(binaryFile.c_str());
+  std::remove(jsonFile.c_str());
+
+  std::cout << "  ✓ Both formats load" << std::endl;
+}
+
+// Test loaded levels come back with features bound to their map
+void testLoadedDoorsBlock() {
+  std::cout << "Testing loaded doors block sight..." << std::endl;
+
+  SaveData original;
+  original.visited_levels.push_back(makeBinaryTestLevel(1));
+  original.visited_levels.push_back(makeBinaryTestLevel(2));
+
+  const std::string binaryFile = "test_doors.bin";
+  const std::string jsonFile = "test_doors.json";
+  saveGame(original, binaryFile);
+  saveGame(original, jsonFile, SaveFormat::Json);
+
+  for (const std::string &file : {binaryFile, jsonFile}) {
+    SaveData loaded = loadGame(file);
+    for (const LevelState &level : loaded.visited_levels) {
+      EXPECT_TRUE(level.features.attachedMap() == &level.map);
+      EXPECT_TRUE(level.map.blocksSight(5, 10)); // closed iron door
+      EXPECT_TRUE(!level.map.isPassable(5, 10));
+      EXPECT_TRUE(!level.map.blocksSight(6, 10));
+    }
+
+    // Moving a level keeps the binding
+    LevelState moved = std::move(loaded.visited_levels[1]);
+    EXPECT_TRUE(moved.features.attachedMap() == &moved.map);
+    EXPECT_TRUE(moved.map.blocksSight(5, 10));
+    moved.features.setDoorState({5, 10}, Door::State::Open);
+    EXPECT_TRUE(!moved.map.blocksSight(5, 10));
+  }
+
+  std::remove(binaryFile.c_str());
+  std::remove(jsonFile.c_str());
+
+  std::cout << "  ✓ Loaded doors block sight and movement" << std::endl;
+}
+
+// Test corrupt binary data is rejected
+void testBinaryCorruptData() {
+  std::cout << "Testing corrupt binary save..." << std::endl;
+
+  SaveData data;
+  data.visited_levels.push_back(makeBinaryTestLevel(1));
+  std::vector<std::uint8_t> bytes = encodeBinary(data);
+
+  // Truncated
+  bool truncated = false;
+  try {
+    decodeBinary(std::span(bytes).first(bytes.size() / 2));
+  } catch (const std::runtime_error &) {
+    truncated = true;
+  }
+  EXPECT_TRUE(truncated);
+
+  // Future version
+  bytes[4] = 0xFF;
+  bool version = false;
+  try {
+    decodeBinary(bytes);
+  } catch (const std::runtime_error &e) {
+    version = std::string(e.what()).find("version") != std::string::npos;
+  }
+  EXPECT_TRUE(version);
+
+  // Feature enum bytes out of range
+  auto featureError = [](std::vector<std::uint8_t> body, std::uint8_t type) {
+    serialization::ByteReader r(body);
+    try {
+      serialization::readFeatureBody(r, type);
+    } catch (const std::runtime_error &e) {
+      return std::string(e.what());
+    }
+    return std::string();
+  };
+  const std::string unknownField = "Save data: unknown feature field";
+  EXPECT_TRUE(featureError({3, 0}, serialization::FEATURE_DOOR) ==
+              unknownField);
+  EXPECT_TRUE(featureError({0, 2}, serialization::FEATURE_DOOR) ==
+              unknownField);
+  EXPECT_TRUE(featureError({2, 4}, serialization::FEATURE_STAIRS) ==
+              unknownField);
+  EXPECT_TRUE(featureError({2, 1}, serialization::FEATURE_DOOR).empty());
+
+  std::cout << "  ✓ Corrupt data rejected" << std::endl;
+}
+
+std::vector<std::uint8_t> jsonBytes(const std::string &text) {
+  return {text.begin(), text.end()};
+}
+
+// Test the streaming JSON loader builds what the DOM path builds
+void testJsonStreamMatchesDom() {
+  std::cout << "Testing streaming JSON loader..." << std::endl;
+
+  SaveData original;
+  original.turn_counter = 77;
+  original.current_level_index = 1;
+  original.visited_levels.push_back(makeBinaryTestLevel(1));
+  original.visited_levels.push_back(makeBinaryTestLevel(2));
+  json j;
+  serialization::to_json(j, original);
+
+  SaveData dom;
+  serialization::from_json(j, dom);
+  SaveData streamed = readJsonSave(jsonBytes(j.dump()));
+
+  EXPECT_EQ(streamed.turn_counter, 77);
+  EXPECT_EQ(streamed.current_level_index, 1);
+  EXPECT_EQ(streamed.visited_levels.size(), 2u);
+  for (std::size_t l = 0; l < 2; ++l) {
+    const LevelState &a = dom.visited_levels[l];
+    const LevelState &b = streamed.visited_levels[l];
+    EXPECT_EQ(b.depth, a.depth);
+    EXPECT_EQ(b.map.width(), a.map.width());
+    EXPECT_EQ(b.map.height(), a.map.height());
+    for (int y = 0; y < a.map.height(); ++y)
+      for (int x = 0; x < a.map.width(); ++x) {
+        EXPECT_TRUE(b.map.at({x, y}) == a.map.at({x, y}));
+        EXPECT_EQ(b.map.isWalkable(x, y), a.map.isWalkable(x, y));
+        EXPECT_EQ(b.map.isOpaque(x, y), a.map.isOpaque(x, y));
+      }
+    EXPECT_TRUE(b.discovered == a.discovered);
+    EXPECT_EQ(b.features.size(), a.features.size());
+    const Door *door = getDoor(*b.features.getFeature({5, 10}));
+    EXPECT_TRUE(door != nullptr);
+    EXPECT_TRUE(door->material == Door::Material::Iron);
+    const Stairs *stairs = getStairs(*b.features.getFeature({20, 12}));
+    EXPECT_TRUE(stairs != nullptr);
+    EXPECT_EQ(stairs->target_depth, a.depth - 1);
+
+    EXPECT_EQ(b.entities.count(), a.entities.count());
+    for (std::size_t i = 0; i < a.entities.count(); ++i) {
+      const Entity &ea = *a.entities.getEntities()[i];
+      const Entity &eb = *b.entities.getEntities()[i];
+      EXPECT_TRUE(eb.getName() == ea.getName());
+      EXPECT_TRUE(eb.getPosition() == ea.getPosition());
+      EXPECT_EQ(eb.getGlyph(), ea.getGlyph());
+      EXPECT_TRUE(eb.getAllProperties() == ea.getAllProperties());
+      EXPECT_EQ(eb.hasAI(), ea.hasAI());
+    }
+  }
+
+  // Key order does not matter and unknown keys are skipped
+  const SaveData reordered = readJsonSave(jsonBytes(R"({
+    "visited_levels": [{
+      "map": {"width": 2, "height": 1, "tiles": [0, 1], "note": [[1], {}]},
+      "extra": {"tiles": "not these"},
+      "entities": [{"ai_type": "SimpleAI", "properties": {"hp": 3},
+                    "glyph": "r", "position": {"y": 0, "x": 1},
+                    "name": "Rat"}],
+      "features": [{"feature": {"type": "Door", "state": 0, "material": 1},
+                    "position": {"x": 0, "y": 0}}],
+      "discovered": [true, false],
+      "depth": 4
+    }],
+    "current_level_index": 0,
+    "turn_counter": 5
+  })"));
+  EXPECT_EQ(reordered.turn_counter, 5);
+  const LevelState &level = reordered.visited_levels.at(0);
+  EXPECT_EQ(level.depth, 4);
+  EXPECT_TRUE(level.map.at({1, 0}) == static_cast<Tile>(1));
+  EXPECT_TRUE(level.discovered == std::vector<bool>({true, false}));
+  EXPECT_TRUE(getDoor(*level.features.getFeature({0, 0})) != nullptr);
+  const Entity *rat = level.entities.getEntityAt({1, 0});
+  EXPECT_TRUE(rat != nullptr);
+  EXPECT_EQ(rat->getProperty("hp"), 3);
+  EXPECT_TRUE(rat->hasAI());
+
+  std::cout << "  ✓ Streaming loader matches the DOM path" << std::endl;
+}
+
+// Test the streaming JSON loader rejects broken saves
+void testJsonStreamErrors() {
+  std::cout << "Testing streaming JSON loader errors..." << std::endl;
+
+  auto errorOf = [](const std::string &text) {
+    try {
+      readJsonSave(jsonBytes(text));
+    } catch (const std::runtime_error &e) {
+      return std::string(e.what());
+    }
+    return std::string();
+  };
+  const std::string level =
+      R"("depth": 1, "features": [], "entities": [], "discovered": [])";
+
+  EXPECT_TRUE(errorOf(R"({"turn_counter": 1,)").find("JSON parse error") !=
+              std::string::npos);
+  EXPECT_TRUE(errorOf("[1, 2]").find("expected an object") !=
+              std::string::npos);
+  EXPECT_TRUE(errorOf(R"({"turn_counter": 1, "visited_levels": []})")
+                  .find("missing current_level_index") != std::string::npos);
+  EXPECT_TRUE(
+      errorOf(R"({"turn_counter": 1, "current_level_index": 0,
+                  "visited_levels": [{"map": {"width": 2, "height": 2,
+                  "tiles": [0, 0, 0]}, )" +
+              level + "}]}")
+          .find("tiles do not match") != std::string::npos);
+  EXPECT_TRUE(
+      errorOf(R"({"turn_counter": 1, "current_level_index": 0,
+                  "visited_levels": [{"map": {"width": 1, "height": 1,
+                  "tiles": [99]}, )" +
+              level + "}]}")
+          .find("unknown tile") != std::string::npos);
+  EXPECT_TRUE(
+      errorOf(R"({"turn_counter": 1, "current_level_index": 0,
+                  "visited_levels": [{"features": [], "entities": [],
+                  "discovered": [], "map": {"width": 1, "height": 1,
+                  "tiles": [0]}}]})")
+          .find("missing depth") != std::string::npos);
+  EXPECT_TRUE(
+      errorOf(R"({"turn_counter": 1, "current_level_index": 0,
+                  "visited_levels": [{"map": {"width": 1, "height": 1,
+                  "tiles": [0]}, "features": [{"position": {"x": 0, "y": 0},
+                  "feature": {"type": "Door", "material": 9, "state": 0}}],
+                  "entities": [], "discovered": [], "depth": 1}]})")
+          .find("unknown material") != std::string::npos);
+  EXPECT_TRUE(
+      errorOf(R"({"turn_counter": 1, "current_level_index": 0,
+                  "visited_levels": [{"map": {"width": 1, "height": 1,
+                  "tiles": [0]}, "features": [{"position": {"x": 0, "y": 0},
+                  "feature": {"type": "Altar"}}],
+                  "entities": [], "discovered": [], "depth": 1}]})") ==
+      "JSON save: unknown feature type Altar");
+
+  std::cout << "  ✓ Broken JSON saves rejected" << std::endl;
+}
+
 // Test error handling for missing file
 void testLoadMissingFile() {
   std::cout << "Testing load missing file error..." << std::endl;
@@ -418,6 +776,17 @@ int main() {
     testSaveLoadFile();
     testLoadMissingFile();
 
+    // Binary format
+    testBinaryRoundTrip();
+    testBinarySize();
+    testLoadDetectsFormat();
+    testBinaryCorruptData();
+    testLoadedDoorsBlock();
+
+    // Streaming JSON loader
+    testJsonStreamMatchesDom();
+    testJsonStreamErrors();
+
     std::cout << "\n✓ All tests passed!" << std::endl;
     return 0;
 
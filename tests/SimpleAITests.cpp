@@ -0,0 +1,74 @@
+#include "../src/ai/SimpleAI.hpp"
+#include "../src/core/Profiler.hpp"
+#include "../src/entities/Entity.hpp"
+#include "../src/entities/EntityManager.hpp"
+#include "../src/entities/TurnManager.hpp"
+#include "../src/world/FeatureManager.hpp"
+#include "../src/world/LevelView.hpp"
+#include "../src/world/Map.hpp"
+#include "include/assertions.hpp"
+#include <iostream>
+
+int main() {
+  using core::Position;
+  using world::Door;
+  using world::Map;
+  using world::Tile;
+
+  // Corridor y = 2 from x = 1 to 12, closed door at x = 6
+  Map map(14, 5, Tile::SolidRock);
+  for (int x = 1; x <= 12; ++x)
+    map.set({x, 2}, Tile::OpenGround);
+  world::FeatureManager features;
+  features.attach(&map);
+  const Position doorPos{6, 2};
+  features.addFeature(doorPos, Door{Door::Material::Wood, Door::State::Closed});
+
+  // Test 1: LevelView - closed door blocks sight and movement
+  world::LevelView view(map, features);
+  EXPECT_TRUE(view.blocksLineOfSight(6, 2));
+  EXPECT_TRUE(view.blocksMovement(6, 2));
+  core::BasicPathfinding<world::LevelView> pathfinder(view);
+  EXPECT_TRUE(pathfinder.findPath({2, 2}, {10, 2}).empty());
+  core::BasicFOV<world::LevelView> fov(view);
+  fov.compute({2, 2}, 10);
+  EXPECT_TRUE(fov.isVisible(6, 2)); // the door itself is seen
+  EXPECT_TRUE(!fov.isVisible(8, 2));
+
+  // Test 2: Opening the door updates the view
+  features.setDoorState(doorPos, Door::State::Open);
+  EXPECT_TRUE(!view.blocksMovement(6, 2));
+  EXPECT_EQ(pathfinder.findPath({2, 2}, {10, 2}).size(), 9u);
+
+  // Test 3: Chasing without a chase map follows one cached path
+  entities::EntityManager entities(map.width(), map.height());
+  entities::TurnManager turnMgr;
+  entities::Entity *player = &entities.createEntity("Player", Position{11, 2});
+  player->setMaxHP(100);
+  player->setHP(100);
+  entities::Entity *goblin = &entities.createEntity("Goblin", Position{2, 2});
+
+  core::Profiler::reset();
+  core::Profiler::setEnabled(true);
+  ai::SimpleAI brain(12);
+  for (int turn = 0; turn < 4; ++turn)
+    brain.act(*goblin, *player, map, features, entities, turnMgr);
+  EXPECT_EQ(goblin->getPosition().x, 6);
+  EXPECT_EQ(core::Profiler::calls(core::ProfileBucket::Pathfinding), 1u);
+
+  // Test 4: Player seen across deep water but unreachable
+  goblin->setPosition({5, 2});
+  features.removeFeature(doorPos);
+  map.set({6, 2}, Tile::DeepLiquid); // does not block sight
+  core::Profiler::reset();
+  for (int turn = 0; turn < 5; ++turn) {
+    brain.act(*goblin, *player, map, features, entities, turnMgr);
+    EXPECT_EQ(goblin->getPosition().x, 5);
+  }
+  // One failed search, then waits instead of searching every turn
+  EXPECT_EQ(core::Profiler::calls(core::ProfileBucket::Pathfinding), 1u);
+  core::Profiler::setEnabled(false);
+
+  std::cout << "SimpleAI tests passed.\n";
+  return EXIT_SUCCESS;
+}
@@ -7,6 +7,10 @@
 
 using namespace world;
 
+#ifndef TEST_TILES_JSON
+#define TEST_TILES_JSON "../test_tiles.json" // run from tests/build
+#endif
+
 // Test enum to string conversion
 void testTileToString() {
   std::cout << "Testing tileToString()..." << std::endl;
@@ -111,6 +115,25 @@ void testWrapperFunction() {
   std::cout << "  ✓ Wrapper function works correctly" << std::endl;
 }
 
+// Test precomputed flag bits and dense table layout
+void testTileFlags() {
+  std::cout << "Testing tile flags..." << std::endl;
+
+  EXPECT_EQ(tileFlags(Tile::OpenGround), 0);
+  EXPECT_EQ(tileFlags(Tile::SolidRock), TILE_BLOCKS_MOVE | TILE_BLOCKS_LOS);
+  EXPECT_EQ(tileFlags(Tile::ShallowLiquid), 0);
+  EXPECT_EQ(tileFlags(Tile::DeepLiquid), TILE_BLOCKS_MOVE);
+  EXPECT_TRUE(blocksMovement(Tile::DeepLiquid));
+  EXPECT_FALSE(blocksLineOfSight(Tile::DeepLiquid));
+  EXPECT_FALSE(isDamaging(Tile::OpenGround));
+
+  // Properties of all tiles share one cache line
+  EXPECT_EQ(alignof(detail::TileTable), 64u);
+  EXPECT_TRUE(sizeof(detail::tileTable.props) <= 64u);
+
+  std::cout << "  ✓ Flags match default properties" << std::endl;
+}
+
 // Test JSON loading with test config
 void testJSONLoading() {
   std::cout << "Testing JSON loading..." << std::endl;
@@ -123,7 +146,7 @@ void testJSONLoading() {
   TileRegistry &reg = TileRegistry::instance();
 
   // Load test config with distinctive values
-  reg.loadFromJSON("../test_tiles.json");
+  reg.loadFromJSON(TEST_TILES_JSON);
 
   // Verify test values were loaded (overriding defaults)
   const auto &og = reg.getProperties(Tile::OpenGround);
@@ -137,6 +160,11 @@ void testJSONLoading() {
   EXPECT_EQ(sl.damage_immediate, 2);
   EXPECT_EQ(sl.damage_per_turn, 3);
 
+  // Flags follow the overrides
+  EXPECT_TRUE(blocksLineOfSight(Tile::ShallowLiquid));
+  EXPECT_TRUE(isDamaging(Tile::ShallowLiquid));
+  EXPECT_FALSE(blocksMovement(Tile::DeepLiquid)); // cost 400 in test file
+
   std::cout << "  ✓ JSON values loaded and override defaults" << std::endl;
 }
 
@@ -215,6 +243,7 @@ int main() {
     // Registry tests
     testRegistryDefaults();
     testWrapperFunction();
+    testTileFlags();
 
     // JSON loading tests
     testJSONLoading();
@@ -1,56 +1,119 @@
 #include "../src/entities/TurnManager.hpp"
 #include "../src/entities/Entity.hpp"
+#include "../src/entities/EntityManager.hpp"
 #include "../src/core/Position.hpp"
 #include "include/assertions.hpp"
 #include <iostream>
+#include <string>
 
 int main() {
   using entities::TurnManager;
   using entities::Entity;
+  using entities::EntityManager;
+
+  // The scheduler queues entities by id, so they live in a manager
+  EntityManager entities;
+  auto spawn = [&entities](const std::string &name) -> Entity & {
+    return entities.createEntity(name, core::Position{0, 0});
+  };
 
   TurnManager turnMgr;
 
   // Test 1: Empty manager
   EXPECT_TRUE(turnMgr.isEmpty());
-  EXPECT_TRUE(turnMgr.getNextActor() == nullptr);
+  EXPECT_TRUE(!turnMgr.getNextActor().valid());
 
   // Test 2: Add entities with different speeds
-  Entity player("Player", {0, 0});
+  Entity &player = spawn("Player");
   player.setProperty("speed", 100);
 
-  Entity fastGoblin("FastGoblin", {1, 1});
+  Entity &fastGoblin = spawn("FastGoblin");
   fastGoblin.setProperty("speed", 150);
 
-  Entity slowOrc("SlowOrc", {2, 2});
+  Entity &slowOrc = spawn("SlowOrc");
   slowOrc.setProperty("speed", 50);
 
-  turnMgr.addEntity(&player);
-  turnMgr.addEntity(&fastGoblin);
-  turnMgr.addEntity(&slowOrc);
+  turnMgr.addEntity(player);
+  turnMgr.addEntity(fastGoblin);
+  turnMgr.addEntity(slowOrc);
   EXPECT_TRUE(!turnMgr.isEmpty());
+  EXPECT_TRUE(turnMgr.contains(slowOrc.getId()));
 
   // Test 3: Fastest entity acts first
-  Entity *actor = turnMgr.getNextActor();
+  Entity *actor = entities.get(turnMgr.getNextActor());
   EXPECT_TRUE(actor != nullptr);
   EXPECT_EQ(actor->getName(), "FastGoblin");
 
   // Test 4: Process turns - fast entity should act more often
-  actor = turnMgr.processTurn();
+  actor = entities.get(turnMgr.processTurn());
   EXPECT_EQ(actor->getName(), "FastGoblin");
 
-  actor = turnMgr.processTurn();
+  actor = entities.get(turnMgr.processTurn());
   EXPECT_EQ(actor->getName(), "Player");
 
-  // Test 5: Remove entity
-  turnMgr.removeEntity(&slowOrc);
+  // Test 5: Remove entity by handle
+  turnMgr.removeEntity(slowOrc.getId());
+  EXPECT_TRUE(!turnMgr.contains(slowOrc.getId()));
   for (int i = 0; i < 10; ++i) {
-    actor = turnMgr.processTurn();
+    actor = entities.get(turnMgr.processTurn());
     EXPECT_TRUE(actor->getName() != "SlowOrc");
   }
 
-  // Test 6: Clear all
+  // Test 6: Fast actor gets proportionally more turns (150 vs 100)
+  TurnManager ratioMgr;
+  Entity &fast = spawn("Fast");
+  fast.setProperty("speed", 150);
+  Entity &normal = spawn("Normal");
+  normal.setProperty("speed", 100);
+  ratioMgr.addEntity(fast);
+  ratioMgr.addEntity(normal);
+  int fastTurns = 0;
+  for (int i = 0; i < 50; ++i) {
+    if (ratioMgr.processTurn() == fast.getId())
+      ++fastTurns;
+  }
+  EXPECT_EQ(fastTurns, 30);
+
+  // Test 7: Equal speeds alternate in insertion order
+  TurnManager fairMgr;
+  Entity &first = spawn("First");
+  Entity &second = spawn("Second");
+  fairMgr.addEntity(first);
+  fairMgr.addEntity(second);
+  EXPECT_TRUE(fairMgr.getNextActor() == first.getId());
+  EXPECT_TRUE(fairMgr.processTurn() == first.getId());
+  EXPECT_TRUE(fairMgr.processTurn() == second.getId());
+  EXPECT_TRUE(fairMgr.processTurn() == first.getId());
+
+  // Test 8: Speed change takes effect after refreshSpeed
+  // (second still spends the energy it already banked)
+  second.setProperty("speed", 0);
+  fairMgr.refreshSpeed(second);
+  EXPECT_TRUE(fairMgr.processTurn() == second.getId());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_TRUE(fairMgr.processTurn() == first.getId());
+  }
+
+  // Test 9: A stale id neither removes nor shadows the slot's new owner
+  TurnManager reuseMgr;
+  Entity &ghost = spawn("Ghost");
+  const core::EntityId ghostId = ghost.getId();
+  reuseMgr.addEntity(ghost);
+  entities.removeEntity(ghostId); // left queued on purpose
+  Entity &heir = spawn("Heir");
+  EXPECT_EQ(heir.getId().index, ghostId.index);
+  reuseMgr.addEntity(heir);
+  EXPECT_TRUE(!reuseMgr.contains(ghostId));
+  EXPECT_TRUE(reuseMgr.contains(heir.getId()));
+  reuseMgr.removeEntity(ghostId);
+  EXPECT_TRUE(reuseMgr.getNextActor() == heir.getId());
+  reuseMgr.removeEntity(heir.getId());
+  EXPECT_TRUE(reuseMgr.isEmpty());
+
+  // Test 10: Clear all
   turnMgr.clear();
   EXPECT_TRUE(turnMgr.isEmpty());
+  EXPECT_TRUE(!turnMgr.contains(player.getId()));
 
   std::cout << "TurnManager tests passed.\n";
   return EXIT_SUCCESS;